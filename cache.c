@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cache.h"
+#include "dfs_pathfinder.h"
+
+/* ---------------------------------- Structures ---------------------------------- */
+
+// One cached result; the obstacle bitset is stored right after the struct
+struct cache_entry {
+    uint32_t hash;            /**< Hash of the key. */
+    int start;                /**< Start vertex of the query. */
+    int goal;                 /**< Goal vertex of the query. */
+    int *path;                /**< Stored path, NULL if the planner found none. */
+    int length;               /**< Number of vertices in path. */
+    int steps;                /**< Steps of the stored run (robot and obstacle moves for DFS). */
+    cache_entry *chain;       /**< Next entry in the same bucket. */
+    cache_entry *newer;       /**< Neighbor towards the head of the LRU list. */
+    cache_entry *older;       /**< Neighbor towards the tail of the LRU list. */
+    uint64_t obstacles[];     /**< Obstacle bitset of the query. */
+};
+
+/* ---------------------------------- Helpers ---------------------------------- */
+
+// Hashes the start, the goal and the obstacle bitset packed in the scratch
+static uint32_t hash_key(const path_cache *c, int start, int goal) {
+    uint64_t h = ((uint64_t)start << 32 | (uint32_t)goal) * 0x9e3779b97f4a7c15ULL;
+    for (int w = 0; w < c->words; w++) {
+        h = (h ^ c->key_scratch[w]) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+    }
+    return (uint32_t)h;
+}
+
+// Packs an obstacle array (size v, 1 for obstacle) into the scratch bitset and hashes the whole key
+static uint32_t make_key(path_cache *c, int start, int goal, const int *obstacles) {
+    memset(c->key_scratch, 0, c->words * sizeof(uint64_t));
+    for (int i = 0; i < c->v; i++) {
+        if (obstacles[i]) c->key_scratch[i >> 6] |= 1ULL << (i & 63);
+    }
+    return hash_key(c, start, goal);
+}
+
+// Same key from a list of obstacle vertices, as used by the DFS planner
+static uint32_t make_key_list(path_cache *c, int start, int goal, const int *obstacles, int num_obstacles) {
+    memset(c->key_scratch, 0, c->words * sizeof(uint64_t));
+    for (int i = 0; i < num_obstacles; i++) {
+        c->key_scratch[obstacles[i] >> 6] |= 1ULL << (obstacles[i] & 63);
+    }
+    return hash_key(c, start, goal);
+}
+
+static size_t entry_bytes(const path_cache *c, int length) {
+    return sizeof(cache_entry) + c->words * sizeof(uint64_t) + length * sizeof(int);
+}
+
+static void lru_unlink(path_cache *c, cache_entry *e) {
+    if (e->newer) e->newer->older = e->older; else c->newest = e->older;
+    if (e->older) e->older->newer = e->newer; else c->oldest = e->newer;
+}
+
+static void lru_push_front(path_cache *c, cache_entry *e) {
+    e->newer = NULL;
+    e->older = c->newest;
+    if (c->newest) c->newest->newer = e;
+    c->newest = e;
+    if (!c->oldest) c->oldest = e;
+}
+
+static cache_entry *find_entry(path_cache *c, uint32_t h, int start, int goal) {
+    for (cache_entry *e = c->buckets[h & c->bucket_mask]; e != NULL; e = e->chain) {
+        if (e->hash == h && e->start == start && e->goal == goal &&
+            memcmp(e->obstacles, c->key_scratch, c->words * sizeof(uint64_t)) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+// Drops the least recently used entry
+static void evict_oldest(path_cache *c) {
+    cache_entry *e = c->oldest;
+    cache_entry **link = &c->buckets[e->hash & c->bucket_mask];
+    while (*link != e) link = &(*link)->chain;
+    *link = e->chain;
+
+    lru_unlink(c, e);
+    c->entries--;
+    c->bytes -= entry_bytes(c, e->length);
+    c->evictions++;
+    free(e->path);
+    free(e);
+}
+
+/* ---------------------------------- Cache ---------------------------------- */
+
+/**
+ * @brief Creates an empty result cache for graphs with v vertices.
+ * @param max_entries Maximum number of cached results.
+ * @param max_bytes Maximum memory held by entries, bitsets and paths.
+ * @note Not thread-safe; use one cache per planning thread.
+ */
+path_cache *path_cache_create(int v, int max_entries, size_t max_bytes) {
+    path_cache *c = calloc(1, sizeof(path_cache));
+    c->v = v;
+    c->words = (v + 63) / 64;
+    c->max_entries = max_entries;
+    c->max_bytes = max_bytes;
+
+    int buckets = 16;
+    while (buckets < 2 * max_entries) buckets *= 2;
+    c->buckets = calloc(buckets, sizeof(cache_entry *));
+    c->bucket_mask = buckets - 1;
+    c->key_scratch = malloc((c->words + 1) * sizeof(uint64_t));
+    return c;
+}
+
+// Looks up the key packed in the scratch; on a hit copies the stored result and steps
+static int lookup_key(path_cache *c, uint32_t h, int start, int goal, path_result *out, int *steps) {
+    cache_entry *e = find_entry(c, h, start, goal);
+    if (!e) {
+        c->misses++;
+        return 0;
+    }
+
+    c->hits++;
+    lru_unlink(c, e);
+    lru_push_front(c, e);
+
+    out->length = e->length;
+    out->path = NULL;
+    if (e->path) {
+        out->path = malloc(e->length * sizeof(int));
+        memcpy(out->path, e->path, e->length * sizeof(int));
+    }
+    if (steps) *steps = e->steps;
+    return 1;
+}
+
+// Stores a copy of a result under the key packed in the scratch, evicting the least recently
+// used entries to stay within the limits
+static void insert_key(path_cache *c, uint32_t h, int start, int goal, path_result result, int steps) {
+    int length = result.path ? result.length : 0;
+    size_t bytes = entry_bytes(c, length);
+    if (bytes > c->max_bytes || c->max_entries <= 0) return;
+    if (find_entry(c, h, start, goal)) return;
+
+    while (c->entries >= c->max_entries || c->bytes + bytes > c->max_bytes) {
+        evict_oldest(c);
+    }
+
+    cache_entry *e = malloc(sizeof(cache_entry) + c->words * sizeof(uint64_t));
+    e->hash = h;
+    e->start = start;
+    e->goal = goal;
+    e->length = length;
+    e->steps = steps;
+    e->path = NULL;
+    if (result.path) {
+        e->path = malloc(length * sizeof(int));
+        memcpy(e->path, result.path, length * sizeof(int));
+    }
+    memcpy(e->obstacles, c->key_scratch, c->words * sizeof(uint64_t));
+
+    e->chain = c->buckets[h & c->bucket_mask];
+    c->buckets[h & c->bucket_mask] = e;
+    lru_push_front(c, e);
+    c->entries++;
+    c->bytes += bytes;
+}
+
+/**
+ * @brief Looks up the result of a query.
+ * @param obstacles Obstacle configuration (array of size v, 1 for obstacle).
+ * @param out On a hit, receives a copy of the stored result that the caller frees.
+ * @return 1 on a hit, 0 on a miss.
+ */
+int path_cache_lookup(path_cache *c, int start, int goal, const int *obstacles, path_result *out) {
+    return lookup_key(c, make_key(c, start, goal, obstacles), start, goal, out, NULL);
+}
+
+// Stores a copy of a result, evicting the least recently used entries to stay within the limits
+void path_cache_insert(path_cache *c, int start, int goal, const int *obstacles, path_result result) {
+    insert_key(c, make_key(c, start, goal, obstacles), start, goal, result, result.path ? result.length - 1 : 0);
+}
+
+void path_cache_free(path_cache *c) {
+    while (c->oldest) {
+        cache_entry *e = c->oldest;
+        lru_unlink(c, e);
+        free(e->path);
+        free(e);
+    }
+    free(c->buckets);
+    free(c->key_scratch);
+    free(c);
+}
+
+/**
+ * @brief dijkstra_rng() behind the result cache.
+ * @return The stored result on a hit (no search), otherwise a fresh search whose
+ *         result is cached. The caller frees the path in both cases.
+ */
+path_result cached_dijkstra(path_cache *c, graph **g, int v, int start, int goal, int *obstacles, int num_obstacles,
+                            rng_stream *rng) {
+    path_result result;
+    uint32_t h = make_key(c, start, goal, obstacles);
+    if (lookup_key(c, h, start, goal, &result, NULL)) return result;
+
+    result = dijkstra_rng(g, v, start, goal, obstacles, num_obstacles, rng);
+    insert_key(c, h, start, goal, result, result.path ? result.length - 1 : 0);
+    return result;
+}
+
+/**
+ * @brief planShortestPathDFS() behind the result cache.
+ * @param obstacles List of obstacle vertices; the DFS moves them in place on a miss.
+ * @param steps Receives the steps of the run, stored or fresh.
+ * @note The key is taken before the search moves the obstacles. Use a separate cache per
+ *       planner: a DFS entry and a Dijkstra entry for the same query would collide.
+ */
+path_result cached_dfs(path_cache *c, struct Graph *graph, int start, int goal, int *obstacles, int num_obstacles,
+                       int *steps, rng_stream *rng) {
+    path_result result;
+    uint32_t h = make_key_list(c, start, goal, obstacles, num_obstacles);
+    if (lookup_key(c, h, start, goal, &result, steps)) return result;
+
+    result = planShortestPathDFS(graph, start, goal, obstacles, num_obstacles, steps, rng, NULL);
+    insert_key(c, h, start, goal, result, *steps); // The scratch still holds the key of the query
+    return result;
+}
+
+// Hit/miss/eviction counters and memory use
+void out_cache_stats(out_writer *w, int format, const path_cache *c) {
+    out_field fields[] = {
+        {"hits",      "Cache: ",            OUT_FIELD_LONG,    c->hits, 0},
+        {"misses",    " hits, ",            OUT_FIELD_LONG,    c->misses, 0},
+        {NULL,        " misses (hit rate ", OUT_FIELD_PERCENT, c->hits, c->hits + c->misses},
+        {"evictions", "%), ",               OUT_FIELD_LONG,    c->evictions, 0},
+        {"entries",   " evictions, ",       OUT_FIELD_INT,     c->entries, 0},
+        {"bytes",     " entries, ",         OUT_FIELD_LONG,    (long long)c->bytes, 0},
+    };
+    out_stats(w, format, REC_CACHE, "cache", fields, sizeof(fields) / sizeof(fields[0]), " bytes\n");
+}
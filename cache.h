@@ -0,0 +1,40 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dijkstras.h"
+#include "output.h"
+
+typedef struct cache_entry cache_entry;
+struct Graph;
+
+// Bounded LRU cache of planner results keyed by (start, goal, obstacle bitset)
+typedef struct {
+    int v;                   /**< Number of vertices of the graph. */
+    int words;               /**< 64-bit words per obstacle bitset. */
+    int max_entries;         /**< Entry limit. */
+    size_t max_bytes;        /**< Memory limit (entries, bitsets and paths). */
+    int entries;             /**< Current number of entries. */
+    size_t bytes;            /**< Current memory use. */
+    cache_entry **buckets;   /**< Hash buckets (chained). */
+    int bucket_mask;         /**< Number of buckets minus one. */
+    cache_entry *newest;     /**< Head of the LRU list. */
+    cache_entry *oldest;     /**< Tail of the LRU list, evicted first. */
+    uint64_t *key_scratch;   /**< Bitset of the query being looked up. */
+    long long hits;          /**< Lookups answered from the cache. */
+    long long misses;        /**< Lookups that had to plan. */
+    long long evictions;     /**< Entries dropped to respect the limits. */
+} path_cache;
+
+path_cache *path_cache_create(int v, int max_entries, size_t max_bytes);
+int path_cache_lookup(path_cache *c, int start, int goal, const int *obstacles, path_result *out);
+void path_cache_insert(path_cache *c, int start, int goal, const int *obstacles, path_result result);
+void path_cache_free(path_cache *c);
+path_result cached_dijkstra(path_cache *c, graph **g, int v, int start, int goal, int *obstacles, int num_obstacles,
+                            rng_stream *rng);
+path_result cached_dfs(path_cache *c, struct Graph *graph, int start, int goal, int *obstacles, int num_obstacles,
+                       int *steps, rng_stream *rng);
+void out_cache_stats(out_writer *w, int format, const path_cache *c);
+
+#endif
@@ -3,7 +3,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 #include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "dfs_pathfinder.h"
+#include "output.h"
+
+// Trace messages of the search, silenced in quiet mode and for structured output
+#define DFS_TRACE(...) do { if (!IS_QUIET && OUTPUT_FORMAT == OUTPUT_TEXT) printf(__VA_ARGS__); } while (0)
+
+// IDs the traces print for the vertices of the graph, NULL when they are printed as they are
+static const int* traceIds = NULL;
+#define TRACE_ID(x) (traceIds ? traceIds[x] : (x))
 
 // Structure for a node in the adjacency list
 struct Node {
@@ -22,6 +36,113 @@ struct Graph {
     struct List* array;
 };
 
+// Parallel search: tasks wanted per thread before the split pass stops deepening, and its depth limit
+#define DFS_TASKS_PER_THREAD 8
+#define DFS_MAX_SPLIT_DEPTH  6
+
+// Nodes a worker searches between checks for idle workers to share its subtree with
+#ifndef DFS_SHARE_INTERVAL
+#define DFS_SHARE_INTERVAL 1024
+#endif
+
+// Largest transposition table, in entries (16 bytes each)
+#define TT_MAX_ENTRIES (1 << 20)
+
+// Entry of the transposition table
+struct TransEntry {
+    uint64_t key;         /**< Zobrist key of the state with the low bit set. */
+    int steps;            /**< Fewest steps with which the state has been reached. */
+    uint32_t generation;  /**< Search that wrote the entry; entries of older searches are empty. */
+};
+
+// Fixed-size transposition table over (robot vertex, obstacle set) states
+struct TransTable {
+    struct TransEntry* entries;   /**< Table slots, indexed by the low bits of the key. */
+    int mask;                     /**< Number of slots minus one. */
+    uint32_t generation;          /**< Current search; bumping it empties the table. */
+    uint64_t* robotKey;           /**< Zobrist value of the robot at each vertex. */
+    uint64_t* obstacleKey;        /**< Zobrist value of an obstacle at each vertex. */
+    struct DFSStats* stats;       /**< Counters of the current search. */
+};
+
+// Path prefix and obstacle layout of a subtree handed to the worker pool
+struct DFSTask {
+    int id;                 /**< Index of the task, also its random stream. */
+    int steps;              /**< Steps taken when the robot enters the last vertex of path. */
+    uint64_t obstacleHash;  /**< Zobrist hash of obstacles. */
+    int pathLength;         /**< Number of vertices in path, the last one is where the task starts. */
+    int* path;              /**< Robot path from the start (points into data). */
+    int* obstacles;         /**< Obstacle positions (points into data). */
+    int data[];
+};
+
+// Double-ended task queue of one worker: the owner pops at the tail, thieves take from the head
+struct DFSDeque {
+    pthread_mutex_t lock;
+    struct DFSTask** items;  /**< Queued tasks. */
+    int head;                /**< Oldest task, next to be stolen. */
+    int tail;                /**< One past the newest task. */
+    int capacity;            /**< Allocated number of items. */
+};
+
+// State shared by the threads of a parallel search
+struct DFSShared {
+    atomic_int bound;         /**< Fewest steps of any path found so far, by any thread. */
+    pthread_mutex_t taskLock; /**< Guards tasks, numTasks and capacity. */
+    struct DFSTask** tasks;   /**< Tasks produced by the split pass and shared by the workers. */
+    int numTasks;             /**< Number of tasks. */
+    int capacity;             /**< Allocated number of tasks. */
+    atomic_int idle;          /**< Workers waiting for a task; the search is over when all are. */
+    pthread_mutex_t idleLock; /**< Guards posted and done, and the changes of idle. */
+    pthread_cond_t wake;      /**< Signalled when a worker queues a task and broadcast when the search is over. */
+    unsigned posted;          /**< Tasks queued by the workers so far; waiting workers sleep until it changes. */
+    bool done;                /**< Every worker was idle, so no task will come. */
+    struct DFSDeque* deques;  /**< One deque per worker. */
+    int threads;              /**< Number of workers. */
+    uint64_t seed;            /**< Seed of the task streams. */
+};
+
+// Where the move loop of a search frame resumes
+enum { DFS_ENTER, DFS_LOOP, DFS_ROBOT, DFS_WAIT, DFS_RETRY, DFS_EXIT };
+
+// Nodes entered between two reads of the clock by a search step with a time budget
+#define DFS_CLOCK_INTERVAL 64
+
+// One vertex of the robot path on the explicit search stack
+struct DFSFrame {
+    int current;            /**< Robot vertex. */
+    int pathIndex;          /**< Position of current in the path, then the path length once entered. */
+    int steps;              /**< Robot and obstacle moves so far. */
+    uint64_t obstacleHash;  /**< Zobrist hash of the obstacle layout. */
+    int phase;              /**< DFS_ENTER .. DFS_EXIT. */
+    bool loop;              /**< The move loop runs another round. */
+    bool robotMoved;        /**< The robot had a free neighbor this round. */
+    struct Node* next;      /**< Next neighbor to try in a robot scan. */
+};
+
+// Search state owned by one thread
+struct DFSWorker {
+    struct Graph* graph;
+    int destination;
+    int obstacleSize;
+    bool* visited;             /**< Vertices on the current robot path. */
+    int* path;                 /**< Current robot path. */
+    int* shortestPath;         /**< Best path found by this worker. */
+    int shortestLength;        /**< Vertices in shortestPath, vertices + 1 if none. */
+    int minSteps;              /**< Steps of shortestPath. */
+    rng_stream* rng;           /**< Stream of the current search or task. */
+    struct TransTable* tt;     /**< Transposition table of this worker. */
+    struct DFSStats stats;     /**< Counters of this worker. */
+    struct DFSShared* shared;  /**< NULL for a sequential search. */
+    int splitDepth;            /**< Path length at which children become tasks, -1 to never split. */
+    int index;                 /**< Position in the pool, selects the deque. */
+    struct DFSFrame* frames;   /**< Explicit search stack, one frame per vertex of the path. */
+    int depth;                 /**< Frames in use. */
+    int* obstacles;            /**< Obstacle positions moved by the search. */
+    int* savedObstacles;       /**< Obstacle positions on entering each frame, restored on leaving it. */
+    int savedCapacity;         /**< Allocated ints of savedObstacles. */
+};
+
 // Function to create a new node
 struct Node* createNode(int data) {
     struct Node* newNode = (struct Node*)malloc(sizeof(struct Node));
@@ -43,20 +164,40 @@ struct Graph* createGraph(int vertices) {
     return graph;
 }
 
+// Function to free a graph and its adjacency lists
+void freeGraph(struct Graph* graph) {
+    for (int i = 0; i < graph->vertices; i++) {
+        struct Node* node = graph->array[i].head;
+        while (node != NULL) {
+            struct Node* next = node->next;
+            free(node);
+            node = next;
+        }
+    }
+    free(graph->array);
+    free(graph);
+}
+
+// Makes the traces print traceIds[x] for vertex x, e.g. the input IDs of a renumbered graph (NULL: x itself).
+// The table is not copied and has to outlive the searches.
+void setDFSTraceIds(const int* ids) {
+    traceIds = ids;
+}
+
 // Function to add an edge to the graph
 void addEdge(struct Graph* graph, int src, int dest) {
     struct Node* newNode = createNode(dest);
     newNode->next = graph->array[src].head;
     graph->array[src].head = newNode;
 
-    printf("Added edge from %d to %d\n", src, dest);
+    DFS_TRACE("Added edge from %d to %d\n", TRACE_ID(src), TRACE_ID(dest));
 
     // Uncomment the following to make it undirected
     
     newNode = createNode(src);
     newNode->next = graph->array[dest].head;
     graph->array[dest].head = newNode;
-    printf("Added edge from %d to %d (undirected)\n", dest, src);
+    DFS_TRACE("Added edge from %d to %d (undirected)\n", TRACE_ID(dest), TRACE_ID(src));
     
 }
 
@@ -103,172 +244,829 @@ void DFSTraversal(struct Graph* graph, int* order, int orderSize) {
 bool isObstacle(int vertex, int* obstacle, int obstacleSize, bool shouldPrint) {
     for (int i = 0; i < obstacleSize; i++) {
         if (obstacle[i] == vertex) {
-            if (shouldPrint) printf("Blocked by obstacle at %d!\n", vertex);
+            if (shouldPrint) DFS_TRACE("Blocked by obstacle at %d!\n", TRACE_ID(vertex));
             return true;
         }
     }
     return false;
 }
 
-void DFSShortestPath(struct Graph* graph, int current, int destination, bool visited[], int path[], int pathIndex,
-                     int* shortestPath, int* shortestLength, int* obstacle, int obstacleSize,
-                     int steps, int* minSteps) {
-    visited[current] = true;
-    path[pathIndex++] = current;
+// Transposition table sized for the graph (up to TT_MAX_ENTRIES) with Zobrist values drawn from a fixed stream
+struct TransTable* createTransTable(int vertices, struct DFSStats* stats) {
+    struct TransTable* tt = (struct TransTable*)malloc(sizeof(struct TransTable));
+    int size = 1024;
+    while (size < 64 * vertices && size < TT_MAX_ENTRIES) size *= 2;
+    tt->entries = (struct TransEntry*)calloc(size, sizeof(struct TransEntry));
+    tt->mask = size - 1;
+    tt->generation = 1;
+    tt->robotKey = (uint64_t*)malloc(vertices * sizeof(uint64_t));
+    tt->obstacleKey = (uint64_t*)malloc(vertices * sizeof(uint64_t));
+    tt->stats = stats;
 
-    printf("\nCurrent path: ");
-    for (int i = 0; i < pathIndex; i++) {
-        printf("%d ", path[i]);
+    rng_stream keys;
+    rng_init(&keys, 0x7a0b2157ULL, 0);
+    for (int i = 0; i < vertices; i++) {
+        tt->robotKey[i] = (uint64_t)rng_next(&keys) << 32 | rng_next(&keys);
+        tt->obstacleKey[i] = (uint64_t)rng_next(&keys) << 32 | rng_next(&keys);
     }
-    printf("\nSteps so far: %d\n", steps);
+    return tt;
+}
+
+// Empties the table in O(1) for the next search
+void resetTransTable(struct TransTable* tt) {
+    if (++tt->generation == 0) { // Wrapped: old entries could look current
+        memset(tt->entries, 0, (tt->mask + 1) * sizeof(struct TransEntry));
+        tt->generation = 1;
+    }
+}
 
-    // Backup obstacle positions
-    int prevObstacles[obstacleSize];
+void freeTransTable(struct TransTable* tt) {
+    free(tt->entries);
+    free(tt->robotKey);
+    free(tt->obstacleKey);
+    free(tt);
+}
+
+// Zobrist hash of an obstacle set: XOR of the values of the occupied vertices
+uint64_t hashObstacles(struct TransTable* tt, int* obstacle, int obstacleSize) {
+    uint64_t h = 0;
     for (int i = 0; i < obstacleSize; i++) {
-        prevObstacles[i] = obstacle[i];
+        h ^= tt->obstacleKey[obstacle[i]];
+    }
+    return h;
+}
+
+// Returns true if the state was already reached with at most `steps` steps (the subtree can be cut off),
+// otherwise records `steps` for it. A colliding state simply replaces the slot.
+bool probeTransTable(struct TransTable* tt, int current, uint64_t obstacleHash, int steps) {
+    uint64_t key = (obstacleHash ^ tt->robotKey[current]) | 1;
+    struct TransEntry* e = &tt->entries[(key >> 1) & tt->mask];
+
+    tt->stats->probes++;
+    if (e->key == key && e->generation == tt->generation && e->steps <= steps) {
+        tt->stats->hits++;
+        return true;
+    }
+    e->key = key;
+    e->steps = steps;
+    e->generation = tt->generation;
+    return false;
+}
+
+// Records `steps` for a state unless it is already stored with fewer steps
+void recordTransTable(struct TransTable* tt, int current, uint64_t obstacleHash, int steps) {
+    uint64_t key = (obstacleHash ^ tt->robotKey[current]) | 1;
+    struct TransEntry* e = &tt->entries[(key >> 1) & tt->mask];
+    if (e->key != key || e->generation != tt->generation || steps < e->steps) {
+        e->key = key;
+        e->steps = steps;
+        e->generation = tt->generation;
+    }
+}
+
+// Moves obstacle `index` to vertex `to`, keeping the obstacle hash in sync
+static void moveObstacle(struct TransTable* tt, int* obstacle, int index, int to, uint64_t* obstacleHash) {
+    *obstacleHash ^= tt->obstacleKey[obstacle[index]] ^ tt->obstacleKey[to];
+    obstacle[index] = to;
+}
+
+// Fewest steps of any path found so far (across all threads for a parallel search)
+static inline int currentBound(struct DFSWorker* w) {
+    if (w->shared) return atomic_load_explicit(&w->shared->bound, memory_order_relaxed);
+    return w->minSteps;
+}
+
+// Keeps the path to the goal if it beats the best known one and publishes its steps as the new bound
+static void recordPath(struct DFSWorker* w, int pathIndex, int steps) {
+    if (steps >= currentBound(w)) return;
+
+    w->minSteps = steps;
+    w->shortestLength = pathIndex;
+    memcpy(w->shortestPath, w->path, pathIndex * sizeof(int));
+    DFS_TRACE("[PATH FOUND] New shortest path found with total steps %d and path length %d\n", w->minSteps, w->shortestLength - 1);
+
+    if (w->shared) {
+        int bound = atomic_load(&w->shared->bound);
+        while (steps < bound && !atomic_compare_exchange_weak(&w->shared->bound, &bound, steps)) {
+        }
     }
+}
+
+// Makes the subtree below the robot entering `child` a task (copies path prefix and obstacles)
+static struct DFSTask* emitTask(struct DFSWorker* w, int child, int pathIndex, int* obstacle, int steps, uint64_t obstacleHash) {
+    struct DFSShared* shared = w->shared;
+    struct DFSTask* task = (struct DFSTask*)malloc(sizeof(struct DFSTask) + (pathIndex + 1 + w->obstacleSize) * sizeof(int));
+    task->steps = steps;
+    task->obstacleHash = obstacleHash;
+    task->pathLength = pathIndex + 1;
+    task->path = task->data;
+    task->obstacles = task->data + pathIndex + 1;
+    memcpy(task->path, w->path, pathIndex * sizeof(int));
+    task->path[pathIndex] = child;
+    memcpy(task->obstacles, obstacle, w->obstacleSize * sizeof(int));
+
+    pthread_mutex_lock(&shared->taskLock);
+    if (shared->numTasks == shared->capacity) {
+        shared->capacity = shared->capacity ? 2 * shared->capacity : 64;
+        shared->tasks = (struct DFSTask**)realloc(shared->tasks, shared->capacity * sizeof(struct DFSTask*));
+    }
+    task->id = shared->numTasks;
+    shared->tasks[shared->numTasks++] = task;
+    pthread_mutex_unlock(&shared->taskLock);
+    return task;
+}
+
+// Pushes the robot entering `current` at position pathIndex of the path onto the explicit stack
+static void pushFrame(struct DFSWorker* w, int current, int pathIndex, int steps, uint64_t obstacleHash) {
+    struct DFSFrame* f = &w->frames[w->depth++];
+    f->current = current;
+    f->pathIndex = pathIndex;
+    f->steps = steps;
+    f->obstacleHash = obstacleHash;
+    f->phase = DFS_ENTER;
+}
+
+// 1 once the CLOCK_MONOTONIC time has reached the deadline
+static inline int deadlinePassed(const struct timespec* deadline) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec);
+}
+
+// Runs the search on the worker's explicit stack until the stack is empty (returns true), or until
+// maxNodes nodes have been entered or the deadline has passed (returns false; 0 and NULL mean no limit).
+// Each frame is one vertex of the robot path and `phase` says where its move loop resumes, so the search
+// can stop between any two frames and go on later with the same moves and the same random draws.
+static bool runDFS(struct DFSWorker* w, long maxNodes, const struct timespec* deadline) {
+    struct Graph* graph = w->graph;
+    struct TransTable* tt = w->tt;
+    bool* visited = w->visited;
+    int* path = w->path;
+    int* obstacle = w->obstacles;
+    int obstacleSize = w->obstacleSize;
+    rng_stream* rng = w->rng;
+    long entered = 0;
+
+    while (w->depth > 0) {
+        struct DFSFrame* f = &w->frames[w->depth - 1];
+        int current = f->current;
+
+        switch (f->phase) {
+        case DFS_ENTER: {
+            if (entered > 0 && maxNodes > 0 && entered >= maxNodes) return false;
+            if (entered > 0 && deadline && entered % DFS_CLOCK_INTERVAL == 0 && deadlinePassed(deadline)) return false;
+            entered++;
 
-    //Checking if the goal was already reached
-    if (current == destination) {
-        if (steps < *minSteps) {
-            *minSteps = steps;
-            *shortestLength = pathIndex;
-            for (int i = 0; i < pathIndex; i++) {
-                shortestPath[i] = path[i];
+            w->stats.nodes++;
+            // Steps never decrease along a branch, so nothing below can beat the best path found so far
+            if (f->steps >= currentBound(w)) {
+                w->depth--;
+                break;
             }
-            printf("[PATH FOUND] New shortest path found with total steps %d and path length %d\n", *minSteps, *shortestLength - 1);
+            if (probeTransTable(tt, current, f->obstacleHash, f->steps)) {
+                DFS_TRACE("[TT] State at %d already reached in %d steps or fewer, cut off\n", TRACE_ID(current), f->steps);
+                w->depth--;
+                break;
+            }
+
+            visited[current] = true;
+            path[f->pathIndex++] = current;
+
+            DFS_TRACE("\nCurrent path: ");
+            for (int i = 0; i < f->pathIndex; i++) {
+                DFS_TRACE("%d ", TRACE_ID(path[i]));
+            }
+            DFS_TRACE("\nSteps so far: %d\n", f->steps);
+
+            // Backup obstacle positions
+            int needed = w->depth * obstacleSize;
+            if (needed > w->savedCapacity) {
+                w->savedCapacity = needed > 2 * w->savedCapacity ? needed : 2 * w->savedCapacity;
+                w->savedObstacles = (int*)realloc(w->savedObstacles, w->savedCapacity * sizeof(int));
+            }
+            memcpy(w->savedObstacles + (w->depth - 1) * obstacleSize, obstacle, obstacleSize * sizeof(int));
+
+            //Checking if the goal was already reached
+            if (current == w->destination) {
+                recordPath(w, f->pathIndex, f->steps);
+                f->phase = DFS_EXIT;
+            } else {
+                f->loop = true;
+                f->phase = DFS_LOOP;
+            }
+            break;
         }
-    } else {
-        bool loop = true;
-        while (loop) {
-            loop = false;
-            int moveCase = rand() % 2; // 0 = robot only, 1 = obstacle only
-            printf("Move case: %d (%s)\n", moveCase,
+
+        case DFS_LOOP: {
+            if (!f->loop) {
+                f->phase = DFS_EXIT;
+                break;
+            }
+            f->loop = false;
+            int moveCase = rng_below(rng, 2); // 0 = robot only, 1 = obstacle only
+            DFS_TRACE("Move case: %d (%s)\n", moveCase,
                 moveCase == 0 ? "robot only" :"obstacle only");
+            f->robotMoved = false;
 
-            bool robotMoved = false;
+            if (moveCase == 0) {
+                f->next = graph->array[current].head;
+                f->phase = DFS_ROBOT;
+                break;
+            }
 
-            // Move obstacles if needed
-            if (moveCase == 1 ) {
-                loop = true; // obstacles moved, may try again
-                int randomObstacleIndex = rand() % obstacleSize;
-                int original = obstacle[randomObstacleIndex];
-                struct Node* neighbor = graph->array[original].head;
+            // Move obstacles
+            f->loop = true; // obstacles moved, may try again
+            int randomObstacleIndex = rng_below(rng, obstacleSize);
+            int original = obstacle[randomObstacleIndex];
+            struct Node* neighbor = graph->array[original].head;
 
-                while (neighbor) {
-                    int candidate = neighbor->data;
-                    if (!isObstacle(candidate, obstacle, obstacleSize, false) && candidate != current) {
-                        printf("[OBSTACLE] Obstacle %d moves to %d\n", original, candidate);
-                        obstacle[randomObstacleIndex] = candidate;
-                        break;
-                    }
-                    if (candidate == current) {
-                        printf("Obstacle movement blocked by candidate!\n");
-                    }
-                    neighbor = neighbor->next;
+            while (neighbor) {
+                int candidate = neighbor->data;
+                if (!isObstacle(candidate, obstacle, obstacleSize, false) && candidate != current) {
+                    DFS_TRACE("[OBSTACLE] Obstacle %d moves to %d\n", TRACE_ID(original), TRACE_ID(candidate));
+                    moveObstacle(tt, obstacle, randomObstacleIndex, candidate, &f->obstacleHash);
+                    break;
                 }
+                if (candidate == current) {
+                    DFS_TRACE("Obstacle movement blocked by candidate!\n");
+                }
+                neighbor = neighbor->next;
+            }
 
-                // Count obstacle move as one step (even if it doesn't move)
-                steps++;
-                
+            // Count obstacle move as one step (even if it doesn't move)
+            f->steps++;
+            if (f->steps >= currentBound(w)) {
+                f->phase = DFS_EXIT;
+                break;
             }
 
-            // Move robot if allowed
-            if (moveCase == 0 ) {
-                struct Node* temp = graph->array[current].head;
-                while (temp) {
-                    int adj = temp->data;
-                    if (!visited[adj] && !isObstacle(adj, obstacle, obstacleSize, true)) {
-                        printf("[ROBOT] Robot exploring from %d to %d\n", current, adj);
-                        // Robot move counts as a step
-                        DFSShortestPath(graph, adj, destination, visited, path, pathIndex,
-                                        shortestPath, shortestLength, obstacle, obstacleSize,
-                                        steps + 1, minSteps);
-                        robotMoved = true;
+            // Record the new layout so robot arrivals in it through other orders of moves are cut off.
+            // This node itself goes on from it, so a match here is not a cutoff.
+            recordTransTable(tt, current, f->obstacleHash, f->steps);
+            break;
+        }
+
+        case DFS_ROBOT:
+        case DFS_RETRY: {
+            // Move the robot to each free neighbor in turn: the child frame runs before the next one is tried,
+            // or at the split depth the subtree is handed to the pool
+            bool pushed = false;
+            while (f->next && !pushed) {
+                int adj = f->next->data;
+                f->next = f->next->next;
+                if (!visited[adj] && !isObstacle(adj, obstacle, obstacleSize, true)) {
+                    if (f->phase == DFS_ROBOT) {
+                        DFS_TRACE("[ROBOT] Robot exploring from %d to %d\n", TRACE_ID(current), TRACE_ID(adj));
+                        f->robotMoved = true;
+                    } else {
+                        DFS_TRACE("[ROBOT] Robot retrying from %d to %d\n", TRACE_ID(current), TRACE_ID(adj));
+                    }
+                    // Robot move counts as a step
+                    if (f->pathIndex == w->splitDepth) {
+                        emitTask(w, adj, f->pathIndex, obstacle, f->steps + 1, f->obstacleHash);
+                    } else {
+                        pushFrame(w, adj, f->pathIndex, f->steps + 1, f->obstacleHash);
+                        pushed = true;
                     }
-                    temp = temp->next;
                 }
             }
+            if (pushed) break;
 
             // If robot did not move, wait and try again
-            if (!robotMoved && (moveCase == 0)) {
-                printf("⏳ Robot is blocked at %d. Waiting for path to clear...\n", current);
-
-                // Try to move obstacles again
-                for (int i = 0; i < obstacleSize; i++) {
-                    int original = obstacle[i];
-                    struct Node* neighbor = graph->array[original].head;
-                    while (neighbor) {
-                        int candidate = neighbor->data;
-                        if (!isObstacle(candidate, obstacle, obstacleSize, false) && candidate != current) {
-                            printf("[OBSTACLE] Obstacle %d (during wait) moves to %d\n", original, candidate);
-                            obstacle[i] = candidate;
-                            break;
-                        }
-                        neighbor = neighbor->next;
+            f->phase = (f->phase == DFS_ROBOT && !f->robotMoved) ? DFS_WAIT : DFS_LOOP;
+            break;
+        }
+
+        case DFS_WAIT: {
+            DFS_TRACE("⏳ Robot is blocked at %d. Waiting for path to clear...\n", TRACE_ID(current));
+
+            // Try to move obstacles again
+            for (int i = 0; i < obstacleSize; i++) {
+                int original = obstacle[i];
+                struct Node* neighbor = graph->array[original].head;
+                while (neighbor) {
+                    int candidate = neighbor->data;
+                    if (!isObstacle(candidate, obstacle, obstacleSize, false) && candidate != current) {
+                        DFS_TRACE("[OBSTACLE] Obstacle %d (during wait) moves to %d\n", TRACE_ID(original), TRACE_ID(candidate));
+                        moveObstacle(tt, obstacle, i, candidate, &f->obstacleHash);
+                        break;
                     }
+                    neighbor = neighbor->next;
                 }
+            }
 
-                // Count obstacle move as a step for waiting
-                steps++;
-
-                // Retry robot movement after obstacle movement
-                struct Node* temp = graph->array[current].head;
-                while (temp) {
-                    int adj = temp->data;
-                    if (!visited[adj] && !isObstacle(adj, obstacle, obstacleSize, true)) {
-                        printf("[ROBOT] Robot retrying from %d to %d\n", current, adj);
-                        DFSShortestPath(graph, adj, destination, visited, path, pathIndex,
-                                        shortestPath, shortestLength, obstacle, obstacleSize,
-                                        steps + 1, minSteps);
-                    }
-                    temp = temp->next;
+            // Count obstacle move as a step for waiting
+            f->steps++;
+            if (f->steps >= currentBound(w)) {
+                f->phase = DFS_EXIT;
+                break;
+            }
+            recordTransTable(tt, current, f->obstacleHash, f->steps);
+
+            // Retry robot movement after obstacle movement
+            f->next = graph->array[current].head;
+            f->phase = DFS_RETRY;
+            break;
+        }
+
+        case DFS_EXIT: {
+            int* prevObstacles = w->savedObstacles + (w->depth - 1) * obstacleSize;
+            visited[current] = false;
+            DFS_TRACE("[BACK] Backtracking robot from %d\n", TRACE_ID(current));
+            // Backtrack obstacle positions
+            for (int i = 0; i < obstacleSize; i++) {
+                if (obstacle[i] != prevObstacles[i]) {
+                    DFS_TRACE("[BACK] Obstacle backtracked from %d to %d\n", TRACE_ID(obstacle[i]), TRACE_ID(prevObstacles[i]));
+                    obstacle[i] = prevObstacles[i];
                 }
             }
+            w->depth--;
+            break;
+        }
         }
     }
+    return true;
+}
 
-    visited[current] = false;
-    printf("[BACK] Backtracking robot from %d\n", current);
-    // Backtrack obstacle positions
-    for (int i = 0; i < obstacleSize; i++) {
-        if (obstacle[i] != prevObstacles[i]) {
-            printf("[BACK] Obstacle backtracked from %d to %d\n", obstacle[i], prevObstacles[i]);
-            obstacle[i] = prevObstacles[i];
+// Searches the subtree below the robot entering `current` at position pathIndex of the path, to the end
+void DFSShortestPath(struct DFSWorker* w, int current, int pathIndex, int* obstacle, int steps, uint64_t obstacleHash) {
+    w->obstacles = obstacle;
+    pushFrame(w, current, pathIndex, steps, obstacleHash);
+    runDFS(w, 0, NULL);
+}
+
+// Allocates the buffers and transposition table of a worker
+static void initWorker(struct DFSWorker* w, struct Graph* graph, int end, int obstacleSize, struct DFSShared* shared) {
+    w->graph = graph;
+    w->destination = end;
+    w->obstacleSize = obstacleSize;
+    w->visited = (bool*)calloc(graph->vertices, sizeof(bool));
+    w->path = (int*)malloc(graph->vertices * sizeof(int));
+    w->shortestPath = (int*)malloc(graph->vertices * sizeof(int));
+    w->shortestLength = graph->vertices + 1;
+    w->minSteps = 1000000; // large initial value
+    w->rng = NULL;
+    memset(&w->stats, 0, sizeof(w->stats));
+    w->tt = createTransTable(graph->vertices, &w->stats);
+    w->shared = shared;
+    w->splitDepth = -1;
+    w->index = 0;
+    w->frames = (struct DFSFrame*)malloc((graph->vertices + 1) * sizeof(struct DFSFrame));
+    w->depth = 0;
+    w->obstacles = NULL;
+    w->savedObstacles = NULL;
+    w->savedCapacity = 0;
+}
+
+static void freeWorker(struct DFSWorker* w) {
+    freeTransTable(w->tt);
+    free(w->visited);
+    free(w->path);
+    free(w->shortestPath);
+    free(w->frames);
+    free(w->savedObstacles);
+}
+
+// Hands the worker's best path to the caller (path is NULL if it found none)
+static path_result takeResult(struct DFSWorker* w, int* totalSteps) {
+    path_result result = {NULL, 0};
+    if (w->shortestLength <= w->graph->vertices) {
+        result.path = w->shortestPath;
+        result.length = w->shortestLength;
+        w->shortestPath = NULL;
+        *totalSteps = w->minSteps;
+    } else {
+        *totalSteps = -1;
+    }
+    return result;
+}
+
+// Runs the DFS search and returns the shortest path found (path is NULL if none).
+// The total number of steps (robot + obstacle moves) is stored in *totalSteps.
+// Random moves come from rng, so concurrent searches with their own streams are independent.
+// Search counters, including the transposition table hit rate, go to *stats if it is not NULL.
+path_result planShortestPathDFS(struct Graph* graph, int start, int end, int* obstacles, int obstacleSize,
+                                int* totalSteps, rng_stream* rng, struct DFSStats* stats) {
+    struct DFSWorker w;
+    initWorker(&w, graph, end, obstacleSize, NULL);
+    w.rng = rng;
+
+    DFS_TRACE("\nFinding shortest path from %d to %d using DFS...\n", TRACE_ID(start), TRACE_ID(end));
+    DFSShortestPath(&w, start, 0, obstacles, 0, hashObstacles(w.tt, obstacles, obstacleSize));
+
+    path_result result = takeResult(&w, totalSteps);
+    if (stats) *stats = w.stats;
+    freeWorker(&w);
+    return result;
+}
+
+// Planner for repeated DFS queries on one graph; buffers and transposition table are allocated once
+struct DFSWorker* createDFSPlanner(struct Graph* graph) {
+    struct DFSWorker* w = (struct DFSWorker*)malloc(sizeof(struct DFSWorker));
+    initWorker(w, graph, -1, 0, NULL);
+    return w;
+}
+
+// Same as planShortestPathDFS(), without heap allocation. The visited set and path are left clean by
+// the backtracking and the transposition table is emptied by bumping its generation, so a query only
+// resets O(1) state. The returned path points into the planner and is valid until its next query.
+path_result planWithDFSPlanner(struct DFSWorker* w, int start, int end, int* obstacles, int obstacleSize,
+                               int* totalSteps, rng_stream* rng, struct DFSStats* stats) {
+    w->destination = end;
+    w->obstacleSize = obstacleSize;
+    w->shortestLength = w->graph->vertices + 1;
+    w->minSteps = 1000000;
+    w->rng = rng;
+    memset(&w->stats, 0, sizeof(w->stats));
+    resetTransTable(w->tt);
+
+    DFSShortestPath(w, start, 0, obstacles, 0, hashObstacles(w->tt, obstacles, obstacleSize));
+
+    path_result result = {NULL, 0};
+    *totalSteps = -1;
+    if (w->shortestLength <= w->graph->vertices) {
+        result.path = w->shortestPath;
+        result.length = w->shortestLength;
+        *totalSteps = w->minSteps;
+    }
+    if (stats) *stats = w->stats;
+    return result;
+}
+
+void freeDFSPlanner(struct DFSWorker* w) {
+    freeWorker(w);
+    free(w);
+}
+
+/* ---------------------------------- Resumable DFS ---------------------------------- */
+
+// Resumable DFS search, see dfsSearchCreate()
+struct DFSSearch {
+    struct DFSWorker worker;  /**< Search state, including the explicit stack. */
+    rng_stream rng;           /**< Private copy of the caller's stream. */
+    int status;               /**< SEARCH_RUNNING, SEARCH_FOUND, SEARCH_NO_PATH or SEARCH_CANCELLED. */
+};
+
+/**
+ * @brief Starts a DFS query that runs in bounded slices through dfsSearchStep().
+ * @param obstacles Obstacle positions, copied into the search.
+ * @param rng Stream to draw the moves from; the search keeps its own copy, so the same seed gives
+ *        the same result as planShortestPathDFS() however the steps are sliced.
+ * @return Search owned by the caller, release it with dfsSearchFree().
+ */
+struct DFSSearch* dfsSearchCreate(struct Graph* graph, int start, int end, int* obstacles, int obstacleSize,
+                                  rng_stream* rng) {
+    struct DFSSearch* s = (struct DFSSearch*)malloc(sizeof(struct DFSSearch));
+    struct DFSWorker* w = &s->worker;
+    initWorker(w, graph, end, obstacleSize, NULL);
+    s->rng = *rng;
+    s->status = SEARCH_RUNNING;
+    w->rng = &s->rng;
+    w->obstacles = (int*)malloc((obstacleSize + 1) * sizeof(int));
+    memcpy(w->obstacles, obstacles, obstacleSize * sizeof(int));
+
+    DFS_TRACE("\nFinding shortest path from %d to %d using DFS...\n", TRACE_ID(start), TRACE_ID(end));
+    pushFrame(w, start, 0, 0, hashObstacles(w->tt, obstacles, obstacleSize));
+    return s;
+}
+
+/**
+ * @brief Continues the search for at most the given budget.
+ * @param maxNodes Maximum number of search nodes to enter (0 = no limit).
+ * @param maxNanos Maximum wall time in nanoseconds (0 = no limit). The clock is read every
+ *        DFS_CLOCK_INTERVAL nodes, so a step may overrun by that many nodes.
+ * @return Status after the step; SEARCH_RUNNING means the budget ran out first. The search is
+ *         exhaustive, so SEARCH_FOUND is only returned once no shorter path can be left.
+ */
+int dfsSearchStep(struct DFSSearch* s, long maxNodes, long maxNanos) {
+    if (s->status != SEARCH_RUNNING) return s->status;
+
+    struct timespec deadline;
+    if (maxNanos > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += maxNanos / 1000000000L;
+        deadline.tv_nsec += maxNanos % 1000000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
         }
     }
+    if (runDFS(&s->worker, maxNodes, maxNanos > 0 ? &deadline : NULL)) {
+        s->status = s->worker.shortestLength <= s->worker.graph->vertices ? SEARCH_FOUND : SEARCH_NO_PATH;
+    }
+    return s->status;
+}
+
+int dfsSearchStatus(const struct DFSSearch* s) {
+    return s->status;
+}
+
+/**
+ * @brief Best path found so far, as a copy the caller frees.
+ * @param totalSteps Receives the steps of the path, -1 if none has been found yet.
+ * @note The search is anytime: while it runs this is the shortest path to the goal found so far
+ *       (path is NULL until the first one), later steps can only shorten it.
+ */
+path_result dfsSearchBestPath(const struct DFSSearch* s, int* totalSteps) {
+    const struct DFSWorker* w = &s->worker;
+    path_result result = {NULL, 0};
+    *totalSteps = -1;
+    if (w->shortestLength <= w->graph->vertices) {
+        result.length = w->shortestLength;
+        result.path = (int*)malloc(result.length * sizeof(int));
+        memcpy(result.path, w->shortestPath, result.length * sizeof(int));
+        *totalSteps = w->minSteps;
+    }
+    return result;
+}
+
+// Counters of the search so far
+struct DFSStats dfsSearchStats(const struct DFSSearch* s) {
+    return s->worker.stats;
+}
+
+// Stops the search; the best path found so far stays available
+void dfsSearchCancel(struct DFSSearch* s) {
+    if (s->status == SEARCH_RUNNING) s->status = SEARCH_CANCELLED;
+}
+
+void dfsSearchFree(struct DFSSearch* s) {
+    free(s->worker.obstacles);
+    freeWorker(&s->worker);
+    free(s);
 }
 
+/* ---------------------------------- Parallel DFS ---------------------------------- */
 
+// The newest task of the worker's own deque, otherwise the oldest one of another deque (NULL if all are empty)
+static struct DFSTask* findTask(struct DFSWorker* w) {
+    struct DFSShared* shared = w->shared;
+    struct DFSDeque* own = &shared->deques[w->index];
+    struct DFSTask* task = NULL;
 
+    pthread_mutex_lock(&own->lock);
+    if (own->tail > own->head) task = own->items[--own->tail];
+    pthread_mutex_unlock(&own->lock);
 
+    for (int k = 1; task == NULL && k < shared->threads; k++) {
+        struct DFSDeque* victim = &shared->deques[(w->index + k) % shared->threads];
+        pthread_mutex_lock(&victim->lock);
+        if (victim->tail > victim->head) {
+            task = victim->items[victim->head++];
+            w->stats.steals++;
+        }
+        pthread_mutex_unlock(&victim->lock);
+    }
+    return task;
+}
+
+// Next task for a worker, sleeping while others still search and may share their subtrees.
+// Only a searching worker adds tasks, so once every worker is idle the search is over (NULL).
+static struct DFSTask* nextTask(struct DFSWorker* w) {
+    struct DFSShared* shared = w->shared;
+    struct DFSTask* task = findTask(w);
+    if (task) return task;
+
+    pthread_mutex_lock(&shared->idleLock);
+    atomic_fetch_add(&shared->idle, 1);
+    while (!shared->done) {
+        if (atomic_load(&shared->idle) == shared->threads) {
+            shared->done = true;
+            pthread_cond_broadcast(&shared->wake);
+            break;
+        }
 
+        // Counted busy again before taking a task, so the others cannot see all idle while it runs.
+        // A task queued from here on changes posted, so the wait below cannot miss it.
+        unsigned posted = shared->posted;
+        atomic_fetch_sub(&shared->idle, 1);
+        pthread_mutex_unlock(&shared->idleLock);
+        task = findTask(w);
+        pthread_mutex_lock(&shared->idleLock);
+        if (task) break;
+
+        atomic_fetch_add(&shared->idle, 1);
+        while (shared->posted == posted && !shared->done && atomic_load(&shared->idle) < shared->threads) {
+            pthread_cond_wait(&shared->wake, &shared->idleLock);
+        }
+    }
+    pthread_mutex_unlock(&shared->idleLock);
+    return task;
+}
+
+// Queues a task at the tail of the worker's own deque
+static void pushTask(struct DFSWorker* w, struct DFSTask* task) {
+    struct DFSDeque* own = &w->shared->deques[w->index];
+    pthread_mutex_lock(&own->lock);
+    if (own->tail == own->capacity) {
+        own->capacity = 2 * own->capacity + 1;
+        own->items = (struct DFSTask**)realloc(own->items, own->capacity * sizeof(struct DFSTask*));
+    }
+    own->items[own->tail++] = task;
+    pthread_mutex_unlock(&own->lock);
+
+    // Wake one waiting worker to take it
+    pthread_mutex_lock(&w->shared->idleLock);
+    w->shared->posted++;
+    pthread_cond_signal(&w->shared->wake);
+    pthread_mutex_unlock(&w->shared->idleLock);
+}
+
+// 1 if a worker is idle while this one's deque is empty, so that nothing is left for it to steal
+static bool shouldShare(struct DFSWorker* w) {
+    if (atomic_load_explicit(&w->shared->idle, memory_order_relaxed) == 0) return false;
+    struct DFSDeque* own = &w->shared->deques[w->index];
+    pthread_mutex_lock(&own->lock);
+    bool empty = own->tail == own->head;
+    pthread_mutex_unlock(&own->lock);
+    return empty;
+}
+
+// Hands the robot moves not yet tried at the shallowest open frame of the stack (the largest subtrees
+// left) to the pool as tasks, as the split pass does at the split depth. The deeper frames have moved
+// obstacles and marked vertices since, so the frame's layout is the backup its child took on entering,
+// and the path prefix stands in for the visited set.
+static void shareWork(struct DFSWorker* w) {
+    for (int d = 0; d < w->depth; d++) {
+        struct DFSFrame* f = &w->frames[d];
+        if ((f->phase != DFS_ROBOT && f->phase != DFS_RETRY) || f->next == NULL) continue;
+
+        int* layout = w->obstacles;
+        if (d + 1 < w->depth && w->frames[d + 1].phase != DFS_ENTER) layout = w->savedObstacles + (d + 1) * w->obstacleSize;
+
+        for (; f->next; f->next = f->next->next) {
+            int adj = f->next->data;
+            bool onPath = false;
+            for (int i = 0; i < f->pathIndex && !onPath; i++) onPath = w->path[i] == adj;
+            if (onPath || isObstacle(adj, layout, w->obstacleSize, false)) continue;
+            if (f->phase == DFS_ROBOT) f->robotMoved = true;
+            if (f->steps + 1 >= currentBound(w)) continue;
+            pushTask(w, emitTask(w, adj, f->pathIndex, layout, f->steps + 1, f->obstacleHash));
+        }
+        return;
+    }
+}
+
+// Worker thread: runs tasks until none is left anywhere. A task is searched in slices of
+// DFS_SHARE_INTERVAL nodes, and between slices part of it is shared if another worker is idle.
+static void* dfsWorkerMain(void* arg) {
+    struct DFSWorker* w = (struct DFSWorker*)arg;
+    int* obstacles = (int*)malloc((w->obstacleSize + 1) * sizeof(int));
+    struct DFSTask* task;
+
+    while ((task = nextTask(w)) != NULL) {
+        // Each task draws from its own stream, whichever thread runs it
+        rng_stream taskRng;
+        rng_init(&taskRng, w->shared->seed, (uint64_t)task->id);
+        w->rng = &taskRng;
+
+        int prefix = task->pathLength - 1;
+        for (int i = 0; i < prefix; i++) w->visited[task->path[i]] = true;
+        memcpy(w->path, task->path, prefix * sizeof(int));
+        memcpy(obstacles, task->obstacles, w->obstacleSize * sizeof(int));
+
+        w->obstacles = obstacles;
+        pushFrame(w, task->path[prefix], prefix, task->steps, task->obstacleHash);
+        while (!runDFS(w, DFS_SHARE_INTERVAL, NULL)) {
+            if (shouldShare(w)) shareWork(w);
+        }
+
+        for (int i = 0; i < prefix; i++) w->visited[task->path[i]] = false;
+    }
+
+    free(obstacles);
+    return NULL;
+}
+
+static void freeTasks(struct DFSShared* shared) {
+    for (int i = 0; i < shared->numTasks; i++) free(shared->tasks[i]);
+    shared->numTasks = 0;
+}
+
+/**
+ * @brief planShortestPathDFS() on a pool of worker threads.
+ * @param threads Number of worker threads, 0 for one per online CPU.
+ * @note The top of the tree is searched once, sequentially, down to a split depth deepened until there
+ *       are DFS_TASKS_PER_THREAD tasks per thread (or DFS_MAX_SPLIT_DEPTH is reached). Every subtree
+ *       below it becomes a task with its own copy of the path prefix and obstacle layout and its own
+ *       random stream. Tasks are dealt round-robin to per-worker deques and idle workers steal from the
+ *       others. When a worker is idle and nothing is left to steal, a busy worker hands the untried moves
+ *       at the top of its stack to the pool as new tasks, so one large subtree does not leave the others
+ *       waiting. The best step count is an atomic shared by all workers, so each prunes against the
+ *       global best. Which thread finds a path first changes the pruning, so results vary between runs.
+ */
+path_result planShortestPathDFSParallel(struct Graph* graph, int start, int end, int* obstacles, int obstacleSize,
+                                        int* totalSteps, rng_stream* rng, int threads, struct DFSStats* stats) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+
+    struct DFSShared shared;
+    memset(&shared, 0, sizeof(shared));
+    atomic_init(&shared.bound, 1000000);
+    atomic_init(&shared.idle, 0);
+    pthread_mutex_init(&shared.taskLock, NULL);
+    pthread_mutex_init(&shared.idleLock, NULL);
+    pthread_cond_init(&shared.wake, NULL);
+    shared.threads = threads;
+    shared.seed = (uint64_t)rng_next(rng) << 32 | rng_next(rng);
+
+    // Split pass, deepened until the tree has been cut into enough tasks
+    struct DFSWorker split;
+    int* splitObstacles = (int*)malloc((obstacleSize + 1) * sizeof(int));
+    DFS_TRACE("\nFinding shortest path from %d to %d using DFS on %d threads...\n", TRACE_ID(start), TRACE_ID(end), threads);
+    for (int depth = 1; ; depth++) {
+        initWorker(&split, graph, end, obstacleSize, &shared);
+        split.splitDepth = depth;
+        rng_stream splitRng = *rng;
+        split.rng = &splitRng;
+        memcpy(splitObstacles, obstacles, obstacleSize * sizeof(int));
+        DFSShortestPath(&split, start, 0, splitObstacles, 0, hashObstacles(split.tt, obstacles, obstacleSize));
+
+        if (shared.numTasks >= DFS_TASKS_PER_THREAD * threads || shared.numTasks == 0 || depth == DFS_MAX_SPLIT_DEPTH) break;
+        freeTasks(&shared);
+        freeWorker(&split);
+        atomic_store(&shared.bound, 1000000);
+    }
+    free(splitObstacles);
+
+    shared.deques = (struct DFSDeque*)calloc(threads, sizeof(struct DFSDeque));
+    for (int i = 0; i < threads; i++) {
+        pthread_mutex_init(&shared.deques[i].lock, NULL);
+        shared.deques[i].capacity = shared.numTasks / threads + 1;
+        shared.deques[i].items = (struct DFSTask**)malloc(shared.deques[i].capacity * sizeof(struct DFSTask*));
+    }
+    for (int t = 0; t < shared.numTasks; t++) {
+        struct DFSDeque* d = &shared.deques[t % threads];
+        d->items[d->tail++] = shared.tasks[t];
+    }
+
+    struct DFSWorker* workers = (struct DFSWorker*)calloc(threads, sizeof(struct DFSWorker));
+    pthread_t* tids = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    for (int i = 0; i < threads; i++) {
+        initWorker(&workers[i], graph, end, obstacleSize, &shared);
+        workers[i].index = i;
+        pthread_create(&tids[i], NULL, dfsWorkerMain, &workers[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tids[i], NULL);
+    }
+
+    // Best path over the split pass and all workers
+    struct DFSWorker* best = &split;
+    for (int i = 0; i < threads; i++) {
+        if (workers[i].minSteps < best->minSteps) best = &workers[i];
+    }
+    path_result result = takeResult(best, totalSteps);
+
+    if (stats) {
+        *stats = split.stats;
+        stats->tasks = shared.numTasks;
+        for (int i = 0; i < threads; i++) {
+            stats->nodes += workers[i].stats.nodes;
+            stats->probes += workers[i].stats.probes;
+            stats->hits += workers[i].stats.hits;
+            stats->steals += workers[i].stats.steals;
+        }
+    }
+
+    for (int i = 0; i < threads; i++) {
+        freeWorker(&workers[i]);
+        pthread_mutex_destroy(&shared.deques[i].lock);
+        free(shared.deques[i].items);
+    }
+    freeWorker(&split);
+    freeTasks(&shared);
+    pthread_mutex_destroy(&shared.taskLock);
+    pthread_mutex_destroy(&shared.idleLock);
+    pthread_cond_destroy(&shared.wake);
+    free(shared.tasks);
+    free(shared.deques);
+    free(workers);
+    free(tids);
+    return result;
+}
 
 // Wrapper to find and print shortest path using DFS
 void findShortestPathDFS(struct Graph* graph, int start, int end, int* obstacles, int obstacleSize) {
-    bool* visited = (bool*)calloc(graph->vertices, sizeof(bool));
-    int* path = (int*)malloc(graph->vertices * sizeof(int));
-    int* shortestPath = (int*)malloc(graph->vertices * sizeof(int));
-    int shortestLength = graph->vertices + 1;
-    int minSteps = 1000000; // large initial value
-
-    printf("\nFinding shortest path from %d to %d using DFS...\n", start, end);
-    DFSShortestPath(graph, start, end, visited, path, 0, shortestPath, &shortestLength, obstacles, obstacleSize, 0, &minSteps);
+    int minSteps;
+    rng_stream rng;
+    rng_init(&rng, (uint64_t)time(NULL), 0);
+    path_result result = planShortestPathDFS(graph, start, end, obstacles, obstacleSize, &minSteps, &rng, NULL);
 
-    if (shortestLength <= graph->vertices) {
+    if (result.path) {
         printf("\nShortest path from %d to %d using DFS: ", start, end);
-        for (int i = 0; i < shortestLength; i++) {
-            printf("%d ", shortestPath[i]);
+        for (int i = 0; i < result.length; i++) {
+            printf("%d ", result.path[i]);
         }
-        printf("\nPath length (robot moves): %d\n", shortestLength - 1);
+        printf("\nPath length (robot moves): %d\n", result.length - 1);
         printf("Total steps (robot + obstacles): %d\n", minSteps);
     } else {
         printf("\nNo path found from %d to %d\n", start, end);
     }
 
-    free(visited);
-    free(path);
-    free(shortestPath);
+    free(result.path);
 }
 
 
@@ -307,3 +1105,18 @@ void findShortestPathDFS(struct Graph* graph, int start, int end, int* obstacles
 
 //     return 0;
 // }
+
+// Node count and transposition table hit rate of a search, and the pool counters of a parallel one
+void out_dfs_stats(out_writer* w, int format, const struct DFSStats* stats) {
+    int parallel = stats->tasks > 0;
+    out_field fields[] = {
+        {"nodes",     "DFS nodes: ",                          OUT_FIELD_LONG,    stats->nodes, 0},
+        {"tt_probes", ", transposition table: ",              OUT_FIELD_LONG,    stats->probes, 0},
+        {"tt_hits",   " probes, ",                            OUT_FIELD_LONG,    stats->hits, 0},
+        {NULL,        " hits (hit rate ",                     OUT_FIELD_PERCENT, stats->hits, stats->probes},
+        {"tasks",     parallel ? "%)\nParallel DFS: " : NULL, OUT_FIELD_LONG,    stats->tasks, 0},
+        {"steals",    parallel ? " tasks, " : NULL,           OUT_FIELD_LONG,    stats->steals, 0},
+    };
+    out_stats(w, format, REC_DFS_STATS, "dfs_stats", fields, sizeof(fields) / sizeof(fields[0]),
+              parallel ? " steals\n" : "%)\n");
+}
@@ -1,8 +1,39 @@
-#ifndef DFS_PATHFINDER_H
-#define DFS_PATHFINDER_H
-
-struct Graph* createGraph(int vertices);
-void addEdge(struct Graph* graph, int src, int dest);
-void findShortestPathDFS(struct Graph* graph, int start, int end, int* obstacles, int obstacleSize);
-
-#endif
+#ifndef DFS_PATHFINDER_H
+#define DFS_PATHFINDER_H
+
+#include "dijkstras.h"
+#include "output.h"
+
+// Counters of one DFS search
+struct DFSStats {
+    long long nodes;   /**< Search nodes entered (robot arrivals at a vertex). */
+    long long probes;  /**< Transposition table lookups. */
+    long long hits;    /**< Lookups that cut off a subtree. */
+    long long tasks;   /**< Subtrees handed to the worker pool (parallel search only). */
+    long long steals;  /**< Tasks taken from another worker's deque. */
+};
+
+struct Graph* createGraph(int vertices);
+void addEdge(struct Graph* graph, int src, int dest);
+void freeGraph(struct Graph* graph);
+void setDFSTraceIds(const int* ids);
+path_result planShortestPathDFS(struct Graph* graph, int start, int end, int* obstacles, int obstacleSize,
+                                int* totalSteps, rng_stream* rng, struct DFSStats* stats);
+path_result planShortestPathDFSParallel(struct Graph* graph, int start, int end, int* obstacles, int obstacleSize,
+                                        int* totalSteps, rng_stream* rng, int threads, struct DFSStats* stats);
+struct DFSWorker* createDFSPlanner(struct Graph* graph);
+path_result planWithDFSPlanner(struct DFSWorker* w, int start, int end, int* obstacles, int obstacleSize,
+                               int* totalSteps, rng_stream* rng, struct DFSStats* stats);
+void freeDFSPlanner(struct DFSWorker* w);
+struct DFSSearch* dfsSearchCreate(struct Graph* graph, int start, int end, int* obstacles, int obstacleSize,
+                                  rng_stream* rng);
+int dfsSearchStep(struct DFSSearch* s, long maxNodes, long maxNanos);
+int dfsSearchStatus(const struct DFSSearch* s);
+path_result dfsSearchBestPath(const struct DFSSearch* s, int* totalSteps);
+struct DFSStats dfsSearchStats(const struct DFSSearch* s);
+void dfsSearchCancel(struct DFSSearch* s);
+void dfsSearchFree(struct DFSSearch* s);
+void findShortestPathDFS(struct Graph* graph, int start, int end, int* obstacles, int obstacleSize);
+void out_dfs_stats(out_writer* w, int format, const struct DFSStats* stats);
+
+#endif
@@ -0,0 +1,197 @@
+/*
+ * Width-specialized Dijkstra kernel. This file is a template: dijkstras.c includes it once per
+ * mask width after defining
+ *   KERNEL_WORDS   number of 64-bit words in an obstacle mask (1, 2, 4), or 0 for a runtime width
+ *   KERNEL_SUFFIX  suffix appended to the generated function names (w64, w128, ...)
+ * With a fixed width every mask loop has a constant trip count, so the compiler unrolls it and
+ * keeps the masks of the current state in registers.
+ * No include guard on purpose.
+ */
+
+#define KCAT_(a, b) a##_##b
+#define KCAT(a, b) KCAT_(a, b)
+#define KFN(name) KCAT(name, KERNEL_SUFFIX)
+
+#if KERNEL_WORDS
+#define KW KERNEL_WORDS
+#else
+#define KW (t->words)
+#endif
+
+// Hash of a (vertex, obstacle mask) state
+static inline uint32_t KFN(state_hash)(const state_table *t, int vertex, const uint64_t *mask) {
+    uint64_t h = (uint64_t)vertex * 0x9e3779b97f4a7c15ULL;
+    for (int w = 0; w < KW; w++) {
+        h = (h ^ mask[w]) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+    }
+    (void)t;
+    return (uint32_t)h;
+}
+
+/**
+ * @brief Looks a state up in the table and inserts it if it is not there yet.
+ * @param created Set to 1 if the state was inserted by this call.
+ * @return Index of the state in the table.
+ */
+static int KFN(state_find_or_insert)(state_table *t, int vertex, const uint64_t *mask, int *created) {
+    uint32_t h = KFN(state_hash)(t, vertex, mask);
+    int slot = h & t->slot_mask;
+
+    while (t->slot_gen[slot] == t->generation) {
+        int id = t->slots[slot];
+        if (t->hash[id] == h && t->vertex[id] == vertex) {
+            const uint64_t *m = t->masks + (long)id * KW;
+            int same = 1;
+            for (int w = 0; w < KW; w++) {
+                if (m[w] != mask[w]) same = 0;
+            }
+            if (same) {
+                *created = 0;
+                return id;
+            }
+        }
+        slot = (slot + 1) & t->slot_mask;
+    }
+
+    int id = state_table_append(t, h, slot);
+    t->vertex[id] = vertex;
+    memcpy(t->masks + (long)id * KW, mask, KW * sizeof(uint64_t));
+    *created = 1;
+    return id;
+}
+
+// Picks the k-th obstacle (in vertex order) of a mask
+static inline int KFN(kth_obstacle)(const state_table *t, const uint64_t *mask, int k) {
+    for (int w = 0; w < KW; w++) {
+        int c = __builtin_popcountll(mask[w]);
+        if (k < c) {
+            uint64_t bits = mask[w];
+            while (k-- > 0) bits &= bits - 1;
+            return w * 64 + __builtin_ctzll(bits);
+        }
+        k -= c;
+    }
+    (void)t;
+    return -1;
+}
+
+// Random free neighbor of an obstacle that is not the robot's vertex, -1 if there is none
+static int KFN(get_random_valid_neighbor)(const state_table *t, graph **g, int obstacle_vertex,
+                                          const uint64_t *mask, int curr_vertex, rng_stream *rng) {
+    int valid_neighbors = 0;
+    for (graph *p = g[obstacle_vertex]; p != NULL; p = p->next) {
+        if (!MASK_TEST(mask, p->x) && p->x != curr_vertex) valid_neighbors++;
+    }
+    if (valid_neighbors == 0) return -1;
+
+    int target_index = rng_below(rng, valid_neighbors);
+    for (graph *p = g[obstacle_vertex]; p != NULL; p = p->next) {
+        if (!MASK_TEST(mask, p->x) && p->x != curr_vertex) {
+            if (target_index-- == 0) return p->x;
+        }
+    }
+    (void)t;
+    return -1;
+}
+
+// Records a new best distance to a state and queues it
+static void KFN(relax)(state_table *t, state_heap *pq, int vertex, const uint64_t *mask, int new_dist, int from) {
+    int created;
+    int id = KFN(state_find_or_insert)(t, vertex, mask, &created);
+    if (created || new_dist < t->dist[id]) {
+        t->dist[id] = new_dist;
+        t->parent[id] = from;
+        heap_push(pq, new_dist, id);
+    }
+}
+
+// Queues the start state with the initial obstacle configuration
+static void KFN(search_start)(dijkstra_search *ctx, int start, const int *obstacles) {
+    state_table *t = &ctx->table;
+    uint64_t cur[KW];
+    memset(cur, 0, sizeof(cur));
+    for (int i = 0; i < ctx->v; i++) {
+        if (obstacles[i]) MASK_SET(cur, i);
+    }
+    KFN(relax)(t, &ctx->pq, start, cur, 0, -1);
+}
+
+/**
+ * @brief Dijkstra over (robot vertex, obstacle mask) states for one mask width.
+ * @param max_expansions Stop after expanding this many states (0 = no limit).
+ * @param deadline Stop once this CLOCK_MONOTONIC time has passed (NULL = no limit),
+ *        checked every SEARCH_CLOCK_INTERVAL expansions.
+ * @return Status of the search; SEARCH_RUNNING if a budget ran out first.
+ * @note Same model as dijkstra(): each expanded state either moves the robot to every free
+ *       neighbor or moves one random obstacle to a random free neighbor (50% each).
+ *       States live in a hash table, so memory grows with the states reached rather than 2^v.
+ *       The queue, the table and the random stream stay in ctx, so a later call continues
+ *       exactly where this one stopped.
+ */
+static int KFN(search_step)(dijkstra_search *ctx, long max_expansions, const struct timespec *deadline) {
+    state_table *t = &ctx->table;
+    state_heap *pq = &ctx->pq;
+    graph **g = ctx->g;
+    long done = 0;
+
+    uint64_t cur[KW], next[KW];
+    while (ctx->status == SEARCH_RUNNING) {
+        if (pq->size == 0) {
+            ctx->status = SEARCH_NO_PATH;
+            break;
+        }
+        if (max_expansions > 0 && done >= max_expansions) break;
+        if (deadline && done > 0 && done % SEARCH_CLOCK_INTERVAL == 0 && deadline_passed(deadline)) break;
+
+        heap_entry e = heap_pop(pq);
+        int s = e.state;
+        if (t->closed[s]) continue;
+        t->closed[s] = 1;
+        done++;
+
+        int curr_vertex = t->vertex[s];
+        int curr_dist = t->dist[s];
+        memcpy(cur, t->masks + (long)s * KW, sizeof(cur)); // The table may move while relaxing
+
+        if (ctx->goal_dist && ctx->goal_dist[curr_vertex] < ctx->goal_dist[t->vertex[ctx->best_state]]) {
+            ctx->best_state = s;
+        }
+        if (curr_vertex == ctx->goal) {
+            ctx->goal_state = s;
+            ctx->status = SEARCH_FOUND;
+            break;
+        }
+
+        if (rng_below(&ctx->rng, 2) == 0) { // Robot move
+            for (graph *p = g[curr_vertex]; p != NULL; p = p->next) {
+                if (!MASK_TEST(cur, p->x)) {
+                    KFN(relax)(t, pq, p->x, cur, curr_dist + 1, s);
+                }
+            }
+        } else { // Obstacle move
+            int obstacle_count = 0;
+            for (int w = 0; w < KW; w++) obstacle_count += __builtin_popcountll(cur[w]);
+            if (obstacle_count == 0) continue;
+
+            int selected = KFN(kth_obstacle)(t, cur, rng_below(&ctx->rng, obstacle_count));
+            int next_pos = KFN(get_random_valid_neighbor)(t, g, selected, cur, curr_vertex, &ctx->rng);
+            if (next_pos != -1) {
+                memcpy(next, cur, sizeof(next));
+                MASK_CLEAR(next, selected);
+                MASK_SET(next, next_pos);
+                KFN(relax)(t, pq, curr_vertex, next, curr_dist + 1, s);
+            }
+        }
+    }
+
+    ctx->expansions += done;
+    return ctx->status;
+}
+
+#undef KW
+#undef KFN
+#undef KCAT
+#undef KCAT_
+#undef KERNEL_WORDS
+#undef KERNEL_SUFFIX
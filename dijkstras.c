@@ -1,8 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <limits.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
 #include <time.h>
+#include "dijkstras.h"
+#include "msbfs.h"
 
 /* ---------------------------------- Structures ---------------------------------- */
 
@@ -12,37 +15,97 @@ typedef struct node {
     struct node *next;  /**< Pointer to the next neighbor in the list. */
 } graph;
 
-// Structure for priority queue nodes
+// Entry of the priority queue: a state of the search and its distance
 typedef struct {
-    int vertex;           /**< Current vertex of the robot. */
-    int dist;             /**< Distance (number of moves) to reach this state. */
-    int *obstacle_config; /**< Array representing obstacle positions. */
-} pq_node;
+    int dist;   /**< Distance (number of moves) to reach the state. */
+    int state;  /**< Index of the state in the state table. */
+} heap_entry;
 
-// Structure for priority queue
+// Binary min-heap on dist
 typedef struct {
-    pq_node *nodes; /**< Array of priority queue nodes. */
-    int size;       /**< Current number of nodes in the queue. */
-    int capacity;   /**< Maximum capacity of the queue. */
-} priority_queue;
+    heap_entry *nodes; /**< Array of heap entries. */
+    int size;          /**< Current number of entries. */
+    int capacity;      /**< Allocated number of entries. */
+} state_heap;
 
-// Structure to return path and its length
+// Search states (robot vertex, obstacle mask) stored in an open-addressing hash table
 typedef struct {
-    int *path;   /**< Array of vertices representing the path. */
-    int length;  /**< Length of the path (number of vertices). */
-} path_result;
+    int words;              /**< 64-bit words per obstacle mask. */
+    int size;               /**< Number of states stored. */
+    int capacity;           /**< Allocated number of states. */
+    int *vertex;            /**< Robot vertex of each state. */
+    int *dist;              /**< Best known distance of each state. */
+    int *parent;            /**< Previous state on the best path, -1 for the start. */
+    unsigned char *closed;  /**< 1 once the state has been expanded. */
+    uint32_t *hash;         /**< Hash of each state, kept for rehashing. */
+    uint64_t *masks;        /**< Obstacle masks, `words` words per state. */
+    int *slots;             /**< Hash slots holding state indices. */
+    uint32_t *slot_gen;     /**< Generation that filled each slot; other values mean empty. */
+    uint32_t generation;    /**< Current query; bumping it empties every slot at once. */
+    int slot_mask;          /**< Number of slots minus one (a power of two). */
+} state_table;
+
+// Resumable search state, see dijkstra_search_create()
+struct dijkstra_search {
+    graph **g;               /**< Adjacency list of the graph. */
+    int v;                   /**< Number of vertices. */
+    int goal;                /**< Goal vertex. */
+    int status;              /**< SEARCH_RUNNING, SEARCH_FOUND, SEARCH_NO_PATH or SEARCH_CANCELLED. */
+    rng_stream rng;          /**< Private copy of the caller's stream, advanced by the search. */
+    state_table table;       /**< States reached so far with their distances and parents. */
+    state_heap pq;           /**< Open states. */
+    int goal_state;          /**< State that reached the goal, -1 until found. */
+    int best_state;          /**< Expanded state closest to the goal (only with goal_dist). */
+    int *goal_dist;          /**< Obstacle-free hops from each vertex to the goal, NULL if not tracked. */
+    long expansions;         /**< States expanded over all steps. */
+    int (*step)(struct dijkstra_search *, long, const struct timespec *); /**< Kernel for the mask width. */
+    void (*start)(struct dijkstra_search *, int, const int *);             /**< Queues the start state. */
+};
+
+// Expansions between two clock reads when a step has a time budget
+#define SEARCH_CLOCK_INTERVAL 64
+
+#define MASK_TEST(m, i)  (((m)[(i) >> 6] >> ((i) & 63)) & 1)
+#define MASK_SET(m, i)   ((m)[(i) >> 6] |= 1ULL << ((i) & 63))
+#define MASK_CLEAR(m, i) ((m)[(i) >> 6] &= ~(1ULL << ((i) & 63)))
 
 /* ---------------------------------- Function Prototypes ---------------------------------- */
-path_result dijkstra(graph **g, int v, int start, int goal, int *obstacles, int num_obstacles);
-priority_queue *create_pq(int capacity);
-void pq_push(priority_queue *pq, int vertex, int dist, int *obstacle_config, int v);
-pq_node pq_pop(priority_queue *pq);
-int is_empty_pq(priority_queue *pq);
-void free_pq(priority_queue *pq);
-int *copy_obstacle_config(int *config, int v);
-int config_equal(int *config1, int *config2, int v);
-int is_valid_move(graph **g, int vertex, int *obstacle_config, int v);
-int get_random_valid_neighbor(graph **g, int obstacle_vertex, int *obstacle_config, int curr_vertex, int v);
+void heap_init(state_heap *pq);
+void heap_push(state_heap *pq, int dist, int state);
+heap_entry heap_pop(state_heap *pq);
+void heap_free(state_heap *pq);
+void state_table_init(state_table *t, int words);
+int state_table_append(state_table *t, uint32_t hash, int slot);
+void state_table_reset(state_table *t);
+void state_table_free(state_table *t);
+static void search_init(dijkstra_search *ctx, graph **g, int v, int start, int goal, int *obstacles, rng_stream *rng);
+static void search_release(dijkstra_search *ctx);
+static path_result trace_path(const state_table *t, int s);
+
+// 1 once the CLOCK_MONOTONIC time has reached the deadline
+static inline int deadline_passed(const struct timespec *deadline) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec);
+}
+
+/* ---------------------------------- Width-Specialized Kernels ---------------------------------- */
+
+#define KERNEL_WORDS 1
+#define KERNEL_SUFFIX w64
+#include "dijkstra_kernel.h"
+
+#define KERNEL_WORDS 2
+#define KERNEL_SUFFIX w128
+#include "dijkstra_kernel.h"
+
+#define KERNEL_WORDS 4
+#define KERNEL_SUFFIX w256
+#include "dijkstra_kernel.h"
+
+#define KERNEL_WORDS 0
+#define KERNEL_SUFFIX dynamic
+#include "dijkstra_kernel.h"
 
 /* ---------------------------------- Dijkstra's Algorithm ---------------------------------- */
 
@@ -60,308 +123,353 @@ int get_random_valid_neighbor(graph **g, int obstacle_vertex, int *obstacle_conf
  *       obstacle move to a random valid neighbor. Assumes valid input parameters.
  */
 path_result dijkstra(graph **g, int v, int start, int goal, int *obstacles, int num_obstacles) {
+    // Seed random number generator
+    rng_stream rng;
+    rng_init(&rng, (uint64_t)time(NULL), 0);
+    return dijkstra_rng(g, v, start, goal, obstacles, num_obstacles, &rng);
+}
+
+/**
+ * @brief Same as dijkstra(), but draws all random moves from the given stream.
+ * @param rng Random stream owned by the caller; reusing a seed reproduces the run.
+ * @note Uses no global state, so independent calls may run concurrently. Dispatches to the
+ *       kernel with the narrowest obstacle mask (64, 128 or 256 bits) that fits v, or to the
+ *       runtime-width kernel for larger graphs.
+ */
+path_result dijkstra_rng(graph **g, int v, int start, int goal, int *obstacles, int num_obstacles, rng_stream *rng) {
+    (void)num_obstacles; // Obstacles are counted from the mask
+
+    dijkstra_search ctx;
+    search_init(&ctx, g, v, start, goal, obstacles, rng);
+    ctx.step(&ctx, 0, NULL);
+    path_result result = trace_path(&ctx.table, ctx.goal_state);
+    *rng = ctx.rng;
+    search_release(&ctx);
+    return result;
+}
+
+/* ---------------------------------- Resumable Search ---------------------------------- */
+
+// Allocates the queue and state table in caller-provided storage and picks the narrowest kernel whose
+// mask holds every vertex. The table stores masks at the kernel's width, rounded up to 1, 2 or 4 words.
+static void search_alloc(dijkstra_search *ctx, graph **g, int v) {
+    ctx->g = g;
+    ctx->v = v;
+    ctx->goal = -1;
+    ctx->status = SEARCH_NO_PATH;
+    ctx->goal_state = -1;
+    ctx->best_state = 0;
+    ctx->goal_dist = NULL;
+    ctx->expansions = 0;
+
+    heap_init(&ctx->pq);
+    if (v <= 64) {
+        state_table_init(&ctx->table, 1);
+        ctx->step = search_step_w64;
+        ctx->start = search_start_w64;
+    } else if (v <= 128) {
+        state_table_init(&ctx->table, 2);
+        ctx->step = search_step_w128;
+        ctx->start = search_start_w128;
+    } else if (v <= 256) {
+        state_table_init(&ctx->table, 4);
+        ctx->step = search_step_w256;
+        ctx->start = search_start_w256;
+    } else {
+        state_table_init(&ctx->table, (v + 63) / 64);
+        ctx->step = search_step_dynamic;
+        ctx->start = search_start_dynamic;
+    }
+}
+
+// Empties the queue and table (O(1), storage is kept) and queues the start state of a new query
+static void search_begin(dijkstra_search *ctx, int start, int goal, int *obstacles, rng_stream *rng) {
+    ctx->goal = goal;
+    ctx->status = SEARCH_RUNNING;
+    ctx->rng = *rng;
+    ctx->goal_state = -1;
+    ctx->best_state = 0;
+    ctx->expansions = 0;
+
+    ctx->pq.size = 0;
+    state_table_reset(&ctx->table);
+    ctx->start(ctx, start, obstacles);
+}
+
+// Sets up a search for one query in caller-provided storage
+static void search_init(dijkstra_search *ctx, graph **g, int v, int start, int goal, int *obstacles, rng_stream *rng) {
+    search_alloc(ctx, g, v);
+    search_begin(ctx, start, goal, obstacles, rng);
+}
+
+static void search_release(dijkstra_search *ctx) {
+    heap_free(&ctx->pq);
+    state_table_free(&ctx->table);
+    free(ctx->goal_dist);
+}
+
+// Path of vertices from the start to state s along the parent links, {NULL, 0} if s < 0
+static path_result trace_path(const state_table *t, int s) {
     path_result result = {NULL, 0};
+    if (s < 0) return result;
 
-    // Seed random number generator
-    srand(time(NULL));
+    result.length = t->dist[s] + 1;
+    result.path = malloc(result.length * sizeof(int));
+    for (int i = result.length - 1; i >= 0; i--) {
+        result.path[i] = t->vertex[s];
+        s = t->parent[s];
+    }
+    return result;
+}
 
-    // Initialize 3D arrays for distances and visited states
-    int ***dist = malloc(v * sizeof(int **));
-    int ***visited = malloc(v * sizeof(int **));
+/**
+ * @brief Starts a search that runs in bounded slices through dijkstra_search_step().
+ * @param obstacles Initial obstacle configuration (array of size v), copied into the search.
+ * @param rng Stream to draw the moves from; the search keeps its own copy, so
+ *        the same seed gives the same result as dijkstra_rng() however the steps are sliced.
+ * @return Search owned by the caller, release it with dijkstra_search_free().
+ * @note Also computes obstacle-free hop distances to the goal (one BFS) so that
+ *       dijkstra_search_best_path() can return a partial path while the search runs.
+ */
+dijkstra_search *dijkstra_search_create(graph **g, int v, int start, int goal, int *obstacles, rng_stream *rng) {
+    dijkstra_search *ctx = malloc(sizeof(dijkstra_search));
+    search_init(ctx, g, v, start, goal, obstacles, rng);
+
+    ctx->goal_dist = malloc((v + 1) * sizeof(int));
+    bfs_single(g, v, goal, ctx->goal_dist);
     for (int i = 0; i < v; i++) {
-        dist[i] = malloc(v * sizeof(int *));
-        visited[i] = malloc(v * sizeof(int *));
-        for (int j = 0; j < v; j++) {
-            dist[i][j] = malloc((1 << v) * sizeof(int));
-            visited[i][j] = malloc((1 << v) * sizeof(int));
-            for (int k = 0; k < (1 << v); k++) {
-                dist[i][j][k] = INT_MAX; // Initialize distances to infinity
-                visited[i][j][k] = 0;    // Mark all states as unvisited
-            }
-        }
+        if (ctx->goal_dist[i] < 0) ctx->goal_dist[i] = INT_MAX;
     }
+    return ctx;
+}
 
-    // Create priority queue for states (vertex, distance, obstacle config)
-    priority_queue *pq = create_pq(v * v * (1 << v));
-    
-    // Initialize starting state: robot at start vertex, initial obstacle config
-    int *initial_config = copy_obstacle_config(obstacles, v);
-    dist[start][0][0] = 0;
-    pq_push(pq, start, 0, initial_config, v);
-    
-    // Initialize parent array for path reconstruction
-    int ****parent = malloc(v * sizeof(int ***));
-    for (int i = 0; i < v; i++) {
-        parent[i] = malloc(v * sizeof(int **));
-        for (int j = 0; j < v; j++) {
-            parent[i][j] = malloc((1 << v) * sizeof(int *));
-            for (int k = 0; k < (1 << v); k++) {
-                parent[i][j][k] = malloc(2 * sizeof(int));
-                parent[i][j][k][0] = -1; // Parent vertex
-                parent[i][j][k][1] = -1; // Parent obstacle config (bit mask)
-            }
-        }
+/**
+ * @brief Continues the search for at most the given budget.
+ * @param max_expansions Maximum number of states to expand (0 = no limit).
+ * @param max_nanos Maximum wall time in nanoseconds (0 = no limit). The clock is read every
+ *        SEARCH_CLOCK_INTERVAL expansions, so a step may overrun by that many expansions.
+ * @return Status after the step; SEARCH_RUNNING means the budget ran out first.
+ */
+int dijkstra_search_step(dijkstra_search *s, long max_expansions, long max_nanos) {
+    if (s->status != SEARCH_RUNNING) return s->status;
+    if (max_nanos <= 0) return s->step(s, max_expansions, NULL);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += max_nanos / 1000000000L;
+    deadline.tv_nsec += max_nanos % 1000000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
     }
+    return s->step(s, max_expansions, &deadline);
+}
 
-    // Process states until queue is empty or goal is reached
-    while (!is_empty_pq(pq)) {
-        pq_node current = pq_pop(pq); // Get state with minimum distance
-        int curr_vertex = current.vertex;
-        int curr_dist = current.dist;
-        int *curr_config = current.obstacle_config;
-        
-        // Convert obstacle configuration to bit mask for indexing
-        int config_mask = 0;
-        for (int i = 0; i < v; i++) {
-            if (curr_config[i]) config_mask |= (1 << i);
-        }
-        // Skip if state already visited
-        if (visited[curr_vertex][0][config_mask]) {
-            free(curr_config);
-            continue;
-        }
-        
-        visited[curr_vertex][0][config_mask] = 1; // Mark state as visited
-        
-        // Check if goal reached
-        if (curr_vertex == goal) {
-            // Reconstruct path
-            int path_len = curr_dist + 1;
-            result.path = malloc(path_len * sizeof(int));
-            result.length = path_len;
-            result.path[path_len - 1] = goal;
-            
-            int v = goal, steps = curr_dist - 1;
-            int curr_mask = config_mask;
-            while (steps >= 0) {
-                result.path[steps] = parent[v][0][curr_mask][0];
-                curr_mask = parent[v][0][curr_mask][1];
-                v = result.path[steps];
-                steps--;
-            }
-            
-            free(curr_config);
-            break;
-        }
-        
-        // Randomly choose robot or obstacle move (50% probability)
-        int move_type = rand() % 2; // 0 for robot, 1 for obstacle
-        
-        if (move_type == 0) { // Robot move
-            // Explore all neighbors of current vertex
-            graph *neighbor = g[curr_vertex];
-            while (neighbor != NULL) {
-                int next_vertex = neighbor->x;
-                if (!curr_config[next_vertex]) { // Check if next vertex is free
-                    int new_dist = curr_dist + 1;
-                    int next_mask = config_mask;
-                    
-                    // Update distance and parent if shorter path found
-                    if (new_dist < dist[next_vertex][0][next_mask]) {
-                        dist[next_vertex][0][next_mask] = new_dist;
-                        int *new_config = copy_obstacle_config(curr_config, v);
-                        pq_push(pq, next_vertex, new_dist, new_config, v);
-                        
-                        parent[next_vertex][0][next_mask][0] = curr_vertex;
-                        parent[next_vertex][0][next_mask][1] = config_mask;
-                    }
-                }
-                neighbor = neighbor->next;
-            }
-        } else { // Obstacle move
-            // Collect vertices with obstacles
-            int *obstacle_vertices = malloc(num_obstacles * sizeof(int));
-            int obstacle_count = 0;
-            for (int i = 0; i < v; i++) {
-                if (curr_config[i]) {
-                    obstacle_vertices[obstacle_count++] = i;
-                }
-            }
-            
-            if (obstacle_count > 0) {
-                // Randomly select one obstacle
-                int selected_obstacle_idx = rand() % obstacle_count;
-                int selected_obstacle = obstacle_vertices[selected_obstacle_idx];
-                
-                // Get a random valid neighbor for the selected obstacle
-                int next_pos = get_random_valid_neighbor(g, selected_obstacle, curr_config, curr_vertex, v);
-                
-                if (next_pos != -1) { // If a valid move exists
-                    int new_dist = curr_dist + 1;
-                    int *new_config = copy_obstacle_config(curr_config, v);
-                    new_config[selected_obstacle] = 0;
-                    new_config[next_pos] = 1;
-                    
-                    int new_mask = 0;
-                    for (int j = 0; j < v; j++) {
-                        if (new_config[j]) new_mask |= (1 << j);
-                    }
-                    
-                    if (new_dist < dist[curr_vertex][0][new_mask]) {
-                        dist[curr_vertex][0][new_mask] = new_dist;
-                        pq_push(pq, curr_vertex, new_dist, new_config, v);
-                        
-                        parent[curr_vertex][0][new_mask][0] = curr_vertex;
-                        parent[curr_vertex][0][new_mask][1] = config_mask;
-                    } else {
-                        free(new_config);
-                    }
-                }
-            }
-            
-            free(obstacle_vertices);
+/**
+ * @brief Allocates a search meant to be reused for many queries on the same graph.
+ * @note Start each query with dijkstra_search_restart(). The queue and state table keep their
+ *       largest size and are emptied in O(1), so queries that stay below that size do not
+ *       allocate. Best partial paths are not tracked (dijkstra_search_best_path() returns the
+ *       start until the goal is found).
+ */
+dijkstra_search *dijkstra_search_alloc(graph **g, int v) {
+    dijkstra_search *ctx = malloc(sizeof(dijkstra_search));
+    search_alloc(ctx, g, v);
+    return ctx;
+}
+
+/**
+ * @brief Drops the current query and starts a new one, keeping the allocated storage.
+ * @note A search from dijkstra_search_create() recomputes its goal distances when the goal
+ *       changes, which allocates; one from dijkstra_search_alloc() never does.
+ */
+void dijkstra_search_restart(dijkstra_search *s, int start, int goal, int *obstacles, rng_stream *rng) {
+    if (s->goal_dist && goal != s->goal) {
+        bfs_single(s->g, s->v, goal, s->goal_dist);
+        for (int i = 0; i < s->v; i++) {
+            if (s->goal_dist[i] < 0) s->goal_dist[i] = INT_MAX;
         }
-        
-        free(curr_config);
     }
-    
-    // Cleanup
-    free_pq(pq);
-    for (int i = 0; i < v; i++) {
-        for (int j = 0; j < v; j++) {
-            for (int k = 0; k < (1 << v); k++) {
-                free(parent[i][j][k]);
-            }
-            free(parent[i][j]);
-            free(dist[i][j]);
-            free(visited[i][j]);
-        }
-        free(parent[i]);
-        free(dist[i]);
-        free(visited[i]);
+    search_begin(s, start, goal, obstacles, rng);
+}
+
+/**
+ * @brief Writes the best path known so far into a caller buffer (see dijkstra_search_best_path()).
+ * @return Number of vertices of the path. Nothing is written if that exceeds capacity.
+ */
+int dijkstra_search_trace(const dijkstra_search *s, int *buffer, int capacity) {
+    const state_table *t = &s->table;
+    int id = s->goal_state >= 0 ? s->goal_state : s->best_state;
+    if (t->size == 0) return 0;
+
+    int length = t->dist[id] + 1;
+    if (length > capacity) return length;
+    for (int i = length - 1; i >= 0; i--) {
+        buffer[i] = t->vertex[id];
+        id = t->parent[id];
     }
-    free(parent);
-    free(dist);
-    free(visited);
-    
-    return result;
+    return length;
+}
+
+int dijkstra_search_status(const dijkstra_search *s) {
+    return s->status;
+}
+
+long dijkstra_search_expansions(const dijkstra_search *s) {
+    return s->expansions;
+}
+
+// The search's copy of the stream, advanced past every draw made so far
+rng_stream dijkstra_search_rng(const dijkstra_search *s) {
+    return s->rng;
+}
+
+/**
+ * @brief Best path known so far, as a copy the caller frees.
+ * @return The path to the goal once found; otherwise the path to the expanded state whose
+ *         vertex is fewest hops from the goal (the last vertex is then not the goal).
+ */
+path_result dijkstra_search_best_path(const dijkstra_search *s) {
+    return trace_path(&s->table, s->goal_state >= 0 ? s->goal_state : s->best_state);
+}
+
+// Stops the search; later steps return SEARCH_CANCELLED and the best path stays available
+void dijkstra_search_cancel(dijkstra_search *s) {
+    if (s->status == SEARCH_RUNNING) s->status = SEARCH_CANCELLED;
 }
 
-// Priority queue implementation
-priority_queue *create_pq(int capacity) {
-    priority_queue *pq = malloc(sizeof(priority_queue));
-    pq->nodes = malloc(capacity * sizeof(pq_node));
+void dijkstra_search_free(dijkstra_search *s) {
+    search_release(s);
+    free(s);
+}
+
+/* ---------------------------------- Priority Queue ---------------------------------- */
+
+void heap_init(state_heap *pq) {
+    pq->capacity = 1024;
     pq->size = 0;
-    pq->capacity = capacity;
-    return pq;
+    pq->nodes = malloc(pq->capacity * sizeof(heap_entry));
 }
 
-void pq_push(priority_queue *pq, int vertex, int dist, int *obstacle_config, int v) {
-    pq_node node = {vertex, dist, obstacle_config};
-    
-    int i = pq->size;
-    pq->nodes[i] = node;
-    pq->size++;
-    
+void heap_push(state_heap *pq, int dist, int state) {
+    if (pq->size == pq->capacity) {
+        pq->capacity *= 2;
+        pq->nodes = realloc(pq->nodes, pq->capacity * sizeof(heap_entry));
+    }
+
     // Heapify up
+    int i = pq->size++;
     while (i > 0) {
         int parent = (i - 1) / 2;
-        if (pq->nodes[parent].dist > pq->nodes[i].dist) {
-            pq_node temp = pq->nodes[parent];
-            pq->nodes[parent] = pq->nodes[i];
-            pq->nodes[i] = temp;
-            i = parent;
-        } else {
-            break;
-        }
+        if (pq->nodes[parent].dist <= dist) break;
+        pq->nodes[i] = pq->nodes[parent];
+        i = parent;
     }
+    pq->nodes[i].dist = dist;
+    pq->nodes[i].state = state;
 }
 
 // Pop the minimum element from the priority queue
-pq_node pq_pop(priority_queue *pq) {
-    pq_node result = pq->nodes[0];
-    
-    pq->nodes[0] = pq->nodes[pq->size - 1];
-    pq->size--;
-    
+heap_entry heap_pop(state_heap *pq) {
+    heap_entry result = pq->nodes[0];
+    heap_entry last = pq->nodes[--pq->size];
+
     // Heapify down
     int i = 0;
     while (1) {
-        int left = 2 * i + 1;
-        int right = 2 * i + 2;
-        int smallest = i;
-        
-        if (left < pq->size && pq->nodes[left].dist < pq->nodes[smallest].dist) {
-            smallest = left;
-        }
-        if (right < pq->size && pq->nodes[right].dist < pq->nodes[smallest].dist) {
-            smallest = right;
-        }
-        
-        if (smallest != i) {
-            pq_node temp = pq->nodes[i];
-            pq->nodes[i] = pq->nodes[smallest];
-            pq->nodes[smallest] = temp;
-            i = smallest;
-        } else {
-            break;
+        int smallest = 2 * i + 1;
+        if (smallest >= pq->size) break;
+        if (smallest + 1 < pq->size && pq->nodes[smallest + 1].dist < pq->nodes[smallest].dist) {
+            smallest++;
         }
+        if (last.dist <= pq->nodes[smallest].dist) break;
+        pq->nodes[i] = pq->nodes[smallest];
+        i = smallest;
     }
-    
-    return result;
-}
+    pq->nodes[i] = last;
 
-// Check if the priority queue is empty
-int is_empty_pq(priority_queue *pq) {
-    return pq->size == 0;
+    return result;
 }
 
-// Free the priority queue
-void free_pq(priority_queue *pq) {
-    for (int i = 0; i < pq->size; i++) {
-        free(pq->nodes[i].obstacle_config);
-    }
+void heap_free(state_heap *pq) {
     free(pq->nodes);
-    free(pq);
 }
 
-// Copy obstacle configuration
-int *copy_obstacle_config(int *config, int v) {
-    int *new_config = malloc(v * sizeof(int));
-    memcpy(new_config, config, v * sizeof(int));
-    return new_config;
+/* ---------------------------------- State Table ---------------------------------- */
+
+void state_table_init(state_table *t, int words) {
+    t->words = words;
+    t->size = 0;
+    t->capacity = 1024;
+    t->vertex = malloc(t->capacity * sizeof(int));
+    t->dist = malloc(t->capacity * sizeof(int));
+    t->parent = malloc(t->capacity * sizeof(int));
+    t->closed = malloc(t->capacity * sizeof(unsigned char));
+    t->hash = malloc(t->capacity * sizeof(uint32_t));
+    t->masks = malloc((long)t->capacity * words * sizeof(uint64_t));
+    t->slot_mask = 2 * t->capacity - 1;
+    t->slots = malloc((t->slot_mask + 1) * sizeof(int));
+    t->slot_gen = calloc(t->slot_mask + 1, sizeof(uint32_t));
+    t->generation = 1;
 }
 
-// Check if two configurations are equal
-int config_equal(int *config1, int *config2, int v) {
-    for (int i = 0; i < v; i++) {
-        if (config1[i] != config2[i]) return 0;
+// Empties the table in O(1), keeping its storage for the next query
+void state_table_reset(state_table *t) {
+    t->size = 0;
+    if (++t->generation == 0) { // Wrapped: old tags could look current
+        memset(t->slot_gen, 0, (t->slot_mask + 1) * sizeof(uint32_t));
+        t->generation = 1;
     }
-    return 1;
 }
 
-// Check if a move is valid (not an obstacle and within bounds)
-int is_valid_move(graph **g, int vertex, int *obstacle_config, int v) {
-    return vertex >= 0 && vertex < v && !obstacle_config[vertex];
-}
+/**
+ * @brief Adds a state with the given hash; the caller fills in vertex and mask.
+ * @param slot Free slot found by the caller's probe, used unless the table grows.
+ * @return Index of the new state.
+ * @note Keeps the load factor at or below 1/2 by doubling storage and slots together.
+ */
+int state_table_append(state_table *t, uint32_t hash, int slot) {
+    if (t->size == t->capacity) {
+        t->capacity *= 2;
+        t->vertex = realloc(t->vertex, t->capacity * sizeof(int));
+        t->dist = realloc(t->dist, t->capacity * sizeof(int));
+        t->parent = realloc(t->parent, t->capacity * sizeof(int));
+        t->closed = realloc(t->closed, t->capacity * sizeof(unsigned char));
+        t->hash = realloc(t->hash, t->capacity * sizeof(uint32_t));
+        t->masks = realloc(t->masks, (long)t->capacity * t->words * sizeof(uint64_t));
 
-// Helper function to get a random valid neighbor
-int get_random_valid_neighbor(graph **g, int obstacle_vertex, int *obstacle_config, int curr_vertex, int v) {
-    // Count valid neighbors
-    graph *neighbor = g[obstacle_vertex];
-    int valid_neighbors = 0;
-    while (neighbor != NULL) {
-        if (!obstacle_config[neighbor->x] && neighbor->x != curr_vertex) {
-            valid_neighbors++;
-        }
-        neighbor = neighbor->next;
-    }
-    
-    if (valid_neighbors == 0) return -1; // No valid neighbors
-    
-    // Select a random valid neighbor
-    int target_index = rand() % valid_neighbors;
-    neighbor = g[obstacle_vertex];
-    int count = 0;
-    while (neighbor != NULL) {
-        if (!obstacle_config[neighbor->x] && neighbor->x != curr_vertex) {
-            if (count == target_index) {
-                return neighbor->x;
-            }
-            count++;
+        // Rehash into twice as many slots
+        free(t->slots);
+        free(t->slot_gen);
+        t->slot_mask = 2 * t->capacity - 1;
+        t->slots = malloc((t->slot_mask + 1) * sizeof(int));
+        t->slot_gen = calloc(t->slot_mask + 1, sizeof(uint32_t));
+        for (int id = 0; id < t->size; id++) {
+            int s = t->hash[id] & t->slot_mask;
+            while (t->slot_gen[s] == t->generation) s = (s + 1) & t->slot_mask;
+            t->slots[s] = id;
+            t->slot_gen[s] = t->generation;
         }
-        neighbor = neighbor->next;
+
+        slot = hash & t->slot_mask;
+        while (t->slot_gen[slot] == t->generation) slot = (slot + 1) & t->slot_mask;
     }
-    
-    return -1; // Should not reach here if valid_neighbors > 0
-}
\ No newline at end of file
+
+    int id = t->size++;
+    t->slots[slot] = id;
+    t->slot_gen[slot] = t->generation;
+    t->hash[id] = hash;
+    t->closed[id] = 0;
+    return id;
+}
+
+void state_table_free(state_table *t) {
+    free(t->vertex);
+    free(t->dist);
+    free(t->parent);
+    free(t->closed);
+    free(t->hash);
+    free(t->masks);
+    free(t->slots);
+    free(t->slot_gen);
+}
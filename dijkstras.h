@@ -1,6 +1,8 @@
 #ifndef DIJKSTRAS_H
 #define DIJKSTRAS_H
 
+#include "rng.h"
+
 typedef struct node graph; // Forward declaration of graph from main.c
 
 // Structure to return path and its length
@@ -9,6 +11,28 @@ typedef struct {
     int length;
 } path_result;
 
+// Status of a resumable search (dijkstra_search_step)
+#define SEARCH_RUNNING   0  // Budget ran out, call dijkstra_search_step() again
+#define SEARCH_FOUND     1  // The goal was reached
+#define SEARCH_NO_PATH   2  // Every reachable state was expanded without reaching the goal
+#define SEARCH_CANCELLED 3  // dijkstra_search_cancel() was called
+
+// Resumable Dijkstra search; the queue, states and parent links live here between steps
+typedef struct dijkstra_search dijkstra_search;
+
 path_result dijkstra(graph **g, int v, int start, int goal, int *obstacles, int num_obstacles);
+path_result dijkstra_rng(graph **g, int v, int start, int goal, int *obstacles, int num_obstacles, rng_stream *rng);
+
+dijkstra_search *dijkstra_search_create(graph **g, int v, int start, int goal, int *obstacles, rng_stream *rng);
+dijkstra_search *dijkstra_search_alloc(graph **g, int v);
+void dijkstra_search_restart(dijkstra_search *s, int start, int goal, int *obstacles, rng_stream *rng);
+int dijkstra_search_step(dijkstra_search *s, long max_expansions, long max_nanos);
+int dijkstra_search_status(const dijkstra_search *s);
+long dijkstra_search_expansions(const dijkstra_search *s);
+rng_stream dijkstra_search_rng(const dijkstra_search *s);
+path_result dijkstra_search_best_path(const dijkstra_search *s);
+int dijkstra_search_trace(const dijkstra_search *s, int *buffer, int capacity);
+void dijkstra_search_cancel(dijkstra_search *s);
+void dijkstra_search_free(dijkstra_search *s);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,427 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "grid.h"
+
+#define COST_STRAIGHT 10
+#define COST_DIAGONAL 14
+
+/* ---------------------------------- Structures ---------------------------------- */
+
+// Entry of the open list
+typedef struct {
+    int f;     /**< Cost so far plus heuristic. */
+    int cell;  /**< Cell index y * width + x. */
+} open_entry;
+
+// Binary min-heap on f
+typedef struct {
+    open_entry *nodes; /**< Array of heap entries. */
+    int size;          /**< Current number of entries. */
+    int capacity;      /**< Allocated number of entries. */
+} open_list;
+
+/* ---------------------------------- Grid ---------------------------------- */
+
+static inline int bit_test(const uint64_t *bits, int i) {
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
+
+// A cell the robot may enter: inside the grid, no wall and no obstacle
+static inline int walkable(const grid_map *m, int x, int y) {
+    if (x < 0 || y < 0 || x >= m->width || y >= m->height) return 0;
+    int i = y * m->width + x;
+    return !bit_test(m->walls, i) && !bit_test(m->occupied, i);
+}
+
+/**
+ * @brief Reads a grid map.
+ * @param filename File with the format
+ *        <width> <height> <connectivity 4|8>
+ *        <height rows of width characters, '#' for a wall, '.' for a free cell>
+ *        <num_obstacles> then one <x> <y> per moving obstacle
+ *        <start x> <start y>
+ *        <goal x> <goal y>
+ * @param start, goal Receive the cell indices y * width + x.
+ */
+grid_map *read_grid(const char *filename, int *start, int *goal) {
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) {
+        printf("Error opening %s\n", filename);
+        exit(1);
+    }
+
+    grid_map *m = calloc(1, sizeof(grid_map));
+    fscanf(fp, "%d %d %d", &m->width, &m->height, &m->connectivity);
+    int cells = m->width * m->height;
+    int words = (cells + 63) / 64;
+    m->walls = calloc(words + 1, sizeof(uint64_t));
+    m->occupied = calloc(words + 1, sizeof(uint64_t));
+
+    for (int i = 0; i < cells; ) {
+        int c = fgetc(fp);
+        if (c == EOF) break;
+        if (c == '#') m->walls[i >> 6] |= 1ULL << (i & 63);
+        if (c == '#' || c == '.') i++;
+    }
+
+    fscanf(fp, "%d", &m->num_obstacles);
+    m->obstacle_cells = malloc((m->num_obstacles + 1) * sizeof(int));
+    for (int i = 0; i < m->num_obstacles; i++) {
+        int x, y;
+        fscanf(fp, "%d %d", &x, &y);
+        m->obstacle_cells[i] = y * m->width + x;
+        m->occupied[m->obstacle_cells[i] >> 6] |= 1ULL << (m->obstacle_cells[i] & 63);
+    }
+
+    int sx, sy, gx, gy;
+    fscanf(fp, "%d %d", &sx, &sy);
+    fscanf(fp, "%d %d", &gx, &gy);
+    *start = sy * m->width + sx;
+    *goal = gy * m->width + gx;
+    fclose(fp);
+
+    m->g_cost = malloc(cells * sizeof(int));
+    m->parent = malloc(cells * sizeof(int));
+    m->seen = calloc(cells, sizeof(int));
+    m->closed = calloc(cells, sizeof(int));
+    return m;
+}
+
+void free_grid(grid_map *m) {
+    free(m->walls);
+    free(m->occupied);
+    free(m->obstacle_cells);
+    free(m->g_cost);
+    free(m->parent);
+    free(m->seen);
+    free(m->closed);
+    free(m);
+}
+
+/* ---------------------------------- Open List ---------------------------------- */
+
+static void open_push(open_list *pq, int f, int cell) {
+    if (pq->size == pq->capacity) {
+        pq->capacity = pq->capacity ? 2 * pq->capacity : 256;
+        pq->nodes = realloc(pq->nodes, pq->capacity * sizeof(open_entry));
+    }
+    int i = pq->size++;
+    while (i > 0 && pq->nodes[(i - 1) / 2].f > f) {
+        pq->nodes[i] = pq->nodes[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    pq->nodes[i].f = f;
+    pq->nodes[i].cell = cell;
+}
+
+static open_entry open_pop(open_list *pq) {
+    open_entry result = pq->nodes[0];
+    open_entry last = pq->nodes[--pq->size];
+    int i = 0;
+    while (1) {
+        int smallest = 2 * i + 1;
+        if (smallest >= pq->size) break;
+        if (smallest + 1 < pq->size && pq->nodes[smallest + 1].f < pq->nodes[smallest].f) smallest++;
+        if (last.f <= pq->nodes[smallest].f) break;
+        pq->nodes[i] = pq->nodes[smallest];
+        i = smallest;
+    }
+    pq->nodes[i] = last;
+    return result;
+}
+
+/* ---------------------------------- Jump Point Search ---------------------------------- */
+
+static inline int sign(int a) {
+    return (a > 0) - (a < 0);
+}
+
+// Octile distance for 8-connected grids, Manhattan distance for 4-connected grids
+static int grid_distance(const grid_map *m, int a, int b) {
+    int dx = abs(a % m->width - b % m->width);
+    int dy = abs(a / m->width - b / m->width);
+    if (m->connectivity == 4) return COST_STRAIGHT * (dx + dy);
+    int diag = dx < dy ? dx : dy;
+    return COST_DIAGONAL * diag + COST_STRAIGHT * (dx + dy - 2 * diag);
+}
+
+/**
+ * @brief Walks from (x, y) in direction (dx, dy) until a jump point is found.
+ * @return Cell of the jump point, or -1 if the walk hits a blocked cell.
+ * @note A jump point is the goal or a cell with a forced neighbor, i.e. a neighbor that
+ *       can only be reached optimally through this cell because of a blocked cell behind it.
+ *       Diagonal walks (8-connected) and vertical walks (4-connected) also stop where a
+ *       straight walk branching off them finds a jump point.
+ */
+static int jump(const grid_map *m, int x, int y, int dx, int dy, int gx, int gy) {
+    while (1) {
+        if (!walkable(m, x, y)) return -1;
+        if (x == gx && y == gy) return y * m->width + x;
+
+        if (m->connectivity == 8) {
+            if (dx != 0 && dy != 0) {
+                if (jump(m, x + dx, y, dx, 0, gx, gy) >= 0 || jump(m, x, y + dy, 0, dy, gx, gy) >= 0) {
+                    return y * m->width + x;
+                }
+            } else if (dx != 0) {
+                if ((walkable(m, x, y - 1) && !walkable(m, x - dx, y - 1)) ||
+                    (walkable(m, x, y + 1) && !walkable(m, x - dx, y + 1))) {
+                    return y * m->width + x;
+                }
+            } else {
+                if ((walkable(m, x - 1, y) && !walkable(m, x - 1, y - dy)) ||
+                    (walkable(m, x + 1, y) && !walkable(m, x + 1, y - dy))) {
+                    return y * m->width + x;
+                }
+            }
+            // No corner cutting: a diagonal step needs both side cells free
+            if (!walkable(m, x + dx, y) || !walkable(m, x, y + dy)) return -1;
+        } else {
+            if (dx != 0) {
+                if ((walkable(m, x, y - 1) && !walkable(m, x - dx, y - 1)) ||
+                    (walkable(m, x, y + 1) && !walkable(m, x - dx, y + 1))) {
+                    return y * m->width + x;
+                }
+            } else {
+                if ((walkable(m, x - 1, y) && !walkable(m, x - 1, y - dy)) ||
+                    (walkable(m, x + 1, y) && !walkable(m, x + 1, y - dy))) {
+                    return y * m->width + x;
+                }
+                if (jump(m, x + 1, y, 1, 0, gx, gy) >= 0 || jump(m, x - 1, y, -1, 0, gx, gy) >= 0) {
+                    return y * m->width + x;
+                }
+            }
+        }
+
+        x += dx;
+        y += dy;
+    }
+}
+
+/**
+ * @brief Directions worth exploring from a cell given the direction it was reached from.
+ * @param dirs Receives up to 8 (dx, dy) pairs.
+ * @return Number of directions.
+ */
+static int pruned_directions(const grid_map *m, int x, int y, int px, int py, int dirs[][2]) {
+    int n = 0;
+
+#define ADD_DIR(ddx, ddy) do { dirs[n][0] = (ddx); dirs[n][1] = (ddy); n++; } while (0)
+
+    if (px < 0) { // Start cell: every direction
+        ADD_DIR(1, 0); ADD_DIR(-1, 0); ADD_DIR(0, 1); ADD_DIR(0, -1);
+        if (m->connectivity == 8) {
+            for (int ddy = -1; ddy <= 1; ddy += 2) {
+                for (int ddx = -1; ddx <= 1; ddx += 2) {
+                    if (walkable(m, x + ddx, y) && walkable(m, x, y + ddy)) ADD_DIR(ddx, ddy);
+                }
+            }
+        }
+        return n;
+    }
+
+    int dx = sign(x - px), dy = sign(y - py);
+    if (m->connectivity == 8) {
+        if (dx != 0 && dy != 0) {
+            ADD_DIR(0, dy);
+            ADD_DIR(dx, 0);
+            if (walkable(m, x, y + dy) && walkable(m, x + dx, y)) ADD_DIR(dx, dy);
+        } else if (dx != 0) {
+            int up = walkable(m, x, y - 1), down = walkable(m, x, y + 1);
+            ADD_DIR(dx, 0);
+            if (walkable(m, x + dx, y)) {
+                if (up) ADD_DIR(dx, -1);
+                if (down) ADD_DIR(dx, 1);
+            }
+            if (up) ADD_DIR(0, -1);
+            if (down) ADD_DIR(0, 1);
+        } else {
+            int left = walkable(m, x - 1, y), right = walkable(m, x + 1, y);
+            ADD_DIR(0, dy);
+            if (walkable(m, x, y + dy)) {
+                if (left) ADD_DIR(-1, dy);
+                if (right) ADD_DIR(1, dy);
+            }
+            if (left) ADD_DIR(-1, 0);
+            if (right) ADD_DIR(1, 0);
+        }
+    } else {
+        if (dx != 0) {
+            ADD_DIR(dx, 0); ADD_DIR(0, -1); ADD_DIR(0, 1);
+        } else {
+            ADD_DIR(0, dy); ADD_DIR(-1, 0); ADD_DIR(1, 0);
+        }
+    }
+
+#undef ADD_DIR
+    return n;
+}
+
+/**
+ * @brief Jump point search from start to goal with the obstacles frozen where they are.
+ * @param expansions Incremented by the number of jump points expanded (may be NULL).
+ * @return Full cell path (every cell, not only jump points), or {NULL, 0} if none exists.
+ * @note The search scratch lives in the map and is reset by bumping the generation,
+ *       so replanning costs no allocation besides the returned path.
+ */
+path_result grid_jps(grid_map *m, int start, int goal, long *expansions) {
+    path_result result = {NULL, 0};
+    open_list pq = {NULL, 0, 0};
+    int w = m->width, gx = goal % w, gy = goal / w;
+
+    int gen = ++m->generation;
+    m->g_cost[start] = 0;
+    m->parent[start] = -1;
+    m->seen[start] = gen;
+    open_push(&pq, grid_distance(m, start, goal), start);
+
+    int found = 0;
+    while (pq.size > 0) {
+        int c = open_pop(&pq).cell;
+        if (m->closed[c] == gen) continue;
+        m->closed[c] = gen;
+        if (expansions) (*expansions)++;
+        if (c == goal) {
+            found = 1;
+            break;
+        }
+
+        int x = c % w, y = c / w;
+        int p = m->parent[c];
+        int dirs[8][2];
+        int n = pruned_directions(m, x, y, p < 0 ? -1 : p % w, p < 0 ? -1 : p / w, dirs);
+
+        for (int i = 0; i < n; i++) {
+            int jp = jump(m, x + dirs[i][0], y + dirs[i][1], dirs[i][0], dirs[i][1], gx, gy);
+            if (jp < 0 || m->closed[jp] == gen) continue;
+
+            int cost = m->g_cost[c] + grid_distance(m, c, jp);
+            if (m->seen[jp] != gen || cost < m->g_cost[jp]) {
+                m->seen[jp] = gen;
+                m->g_cost[jp] = cost;
+                m->parent[jp] = c;
+                open_push(&pq, cost + grid_distance(m, jp, goal), jp);
+            }
+        }
+    }
+    free(pq.nodes);
+    if (!found) return result;
+
+    // Expand the jump points into single-cell steps
+    int length = 1;
+    for (int c = goal; m->parent[c] >= 0; c = m->parent[c]) {
+        int p = m->parent[c];
+        int dx = abs(c % w - p % w), dy = abs(c / w - p / w);
+        length += dx > dy ? dx : dy;
+    }
+    result.length = length;
+    result.path = malloc(length * sizeof(int));
+
+    int k = length - 1;
+    result.path[k] = goal;
+    for (int c = goal; m->parent[c] >= 0; c = m->parent[c]) {
+        int p = m->parent[c];
+        int sx = sign(p % w - c % w), sy = sign(p / w - c / w);
+        int x = c % w, y = c / w;
+        while (y * w + x != p) {
+            x += sx;
+            y += sy;
+            result.path[--k] = y * w + x;
+        }
+    }
+    return result;
+}
+
+/* ---------------------------------- Navigation ---------------------------------- */
+
+// Moves one random obstacle to a random free neighbor cell other than the robot's
+static void move_random_obstacle(grid_map *m, int robot, rng_stream *rng) {
+    if (m->num_obstacles == 0) return;
+
+    int k = rng_below(rng, m->num_obstacles);
+    int c = m->obstacle_cells[k], w = m->width;
+    int x = c % w, y = c / w;
+    int candidates[8], n = 0;
+
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dy == 0) continue;
+            if (m->connectivity == 4 && dx != 0 && dy != 0) continue;
+            if (walkable(m, x + dx, y + dy) && (y + dy) * w + x + dx != robot) {
+                candidates[n++] = (y + dy) * w + x + dx;
+            }
+        }
+    }
+    if (n == 0) return;
+
+    int next = candidates[rng_below(rng, n)];
+    m->occupied[c >> 6] &= ~(1ULL << (c & 63));
+    m->occupied[next >> 6] |= 1ULL << (next & 63);
+    m->obstacle_cells[k] = next;
+}
+
+// A single move the robot may make now: the next cell is free and a diagonal move does not cut past
+// a blocked side cell, the same rule as jump() and pruned_directions()
+static int step_open(const grid_map *m, int from, int to) {
+    int w = m->width;
+    int x = from % w, y = from / w, nx = to % w, ny = to / w;
+    if (!walkable(m, nx, ny)) return 0;
+    if (nx != x && ny != y) return walkable(m, nx, y) && walkable(m, x, ny);
+    return 1;
+}
+
+/**
+ * @brief Drives the robot from start to goal while the obstacles move.
+ * @param max_steps Give up after this many steps.
+ * @param stats Receives the step, replan and expansion counts.
+ * @return The robot cell after every step (the start included), or {NULL, 0} if the
+ *         goal was not reached within max_steps.
+ * @note Same model as the graph planners: each step is a robot move or a move of one
+ *       random obstacle (50% each). The robot follows its current plan and replans
+ *       with jump point search only when an obstacle blocks the next cell or, for a
+ *       diagonal step, one of the two cells beside it.
+ */
+path_result grid_navigate(grid_map *m, int start, int goal, int max_steps, rng_stream *rng, grid_stats *stats) {
+    path_result result = {NULL, 0};
+    int length = 0, robot = start;
+
+    stats->steps = 0;
+    stats->replans = 1;
+    stats->expansions = 0;
+    path_result plan = grid_jps(m, robot, goal, &stats->expansions);
+    int plan_index = 0;
+
+    // The trace grows with the run instead of being sized for max_steps up front
+    int capacity = plan.path ? 2 * plan.length : 256;
+    int *trace = malloc(capacity * sizeof(int));
+    trace[length++] = robot;
+    while (robot != goal && stats->steps < max_steps) {
+        if (rng_below(rng, 2) == 0) { // Robot move
+            if (!plan.path || !step_open(m, robot, plan.path[plan_index + 1])) {
+                free(plan.path);
+                plan = grid_jps(m, robot, goal, &stats->expansions);
+                plan_index = 0;
+                stats->replans++;
+            }
+            if (plan.path) robot = plan.path[++plan_index]; // Otherwise wait for the way to clear
+        } else { // Obstacle move
+            move_random_obstacle(m, robot, rng);
+        }
+        stats->steps++;
+        if (length == capacity) {
+            capacity *= 2;
+            trace = realloc(trace, capacity * sizeof(int));
+        }
+        trace[length++] = robot;
+    }
+    free(plan.path);
+
+    if (robot == goal) {
+        result.path = trace;
+        result.length = length;
+    } else {
+        free(trace);
+    }
+    return result;
+}
@@ -0,0 +1,35 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <stdint.h>
+#include "dijkstras.h"
+
+// Occupancy grid; neighbors are computed from coordinates, nothing is stored per edge
+typedef struct {
+    int width;              /**< Number of columns. */
+    int height;             /**< Number of rows. */
+    int connectivity;       /**< 4 or 8 (diagonal moves only if both side cells are free). */
+    uint64_t *walls;        /**< Static occupancy bitmap, bit y * width + x. */
+    uint64_t *occupied;     /**< Cells currently holding a moving obstacle. */
+    int num_obstacles;      /**< Number of moving obstacles. */
+    int *obstacle_cells;    /**< Cell of each moving obstacle. */
+    int *g_cost;            /**< Search scratch: cost from the start. */
+    int *parent;            /**< Search scratch: previous jump point. */
+    int *seen;              /**< Search scratch: generation in which g_cost was set. */
+    int *closed;            /**< Search scratch: generation in which the cell was expanded. */
+    int generation;         /**< Current search; bumping it resets the scratch arrays. */
+} grid_map;
+
+// Counters of a grid navigation run
+typedef struct {
+    int steps;        /**< Robot and obstacle moves taken. */
+    int replans;      /**< Jump point searches run. */
+    long expansions;  /**< Jump points expanded over all searches. */
+} grid_stats;
+
+grid_map *read_grid(const char *filename, int *start, int *goal);
+void free_grid(grid_map *m);
+path_result grid_jps(grid_map *m, int start, int goal, long *expansions);
+path_result grid_navigate(grid_map *m, int start, int goal, int max_steps, rng_stream *rng, grid_stats *stats);
+
+#endif
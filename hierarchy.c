@@ -0,0 +1,507 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hierarchy.h"
+
+//Structure for the graph
+typedef struct node{
+    int x;
+    struct node *next;
+}graph;
+
+/* ---------------------------------- Structures ---------------------------------- */
+
+// Entry of the abstract search queue
+typedef struct {
+    int dist;  /**< Cost from the start. */
+    int node;  /**< Boundary vertex, or v for the goal. */
+} abstract_entry;
+
+// Binary min-heap on dist
+typedef struct {
+    abstract_entry *nodes; /**< Array of heap entries. */
+    int size;              /**< Current number of entries. */
+    int capacity;          /**< Allocated number of entries. */
+} abstract_heap;
+
+/* ---------------------------------- Abstract Heap ---------------------------------- */
+
+static void abstract_push(abstract_heap *pq, int dist, int node) {
+    if (pq->size == pq->capacity) {
+        pq->capacity = pq->capacity ? 2 * pq->capacity : 256;
+        pq->nodes = realloc(pq->nodes, pq->capacity * sizeof(abstract_entry));
+    }
+    int i = pq->size++;
+    while (i > 0 && pq->nodes[(i - 1) / 2].dist > dist) {
+        pq->nodes[i] = pq->nodes[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    pq->nodes[i].dist = dist;
+    pq->nodes[i].node = node;
+}
+
+static abstract_entry abstract_pop(abstract_heap *pq) {
+    abstract_entry result = pq->nodes[0];
+    abstract_entry last = pq->nodes[--pq->size];
+    int i = 0;
+    while (1) {
+        int smallest = 2 * i + 1;
+        if (smallest >= pq->size) break;
+        if (smallest + 1 < pq->size && pq->nodes[smallest + 1].dist < pq->nodes[smallest].dist) smallest++;
+        if (last.dist <= pq->nodes[smallest].dist) break;
+        pq->nodes[i] = pq->nodes[smallest];
+        i = smallest;
+    }
+    pq->nodes[i] = last;
+    return result;
+}
+
+/* ---------------------------------- Clusters ---------------------------------- */
+
+// Hops from the last cluster_bfs() source to x, -1 if x was not reached
+static inline int bfs_dist_of(const hierarchy *h, int x) {
+    return h->bfs_seen[x] == h->bfs_gen ? h->bfs_dist[x] : -1;
+}
+
+/**
+ * @brief BFS from source that never leaves the source's cluster or enters a blocked vertex.
+ * @param target Stop as soon as this vertex is reached (-1 = explore the whole cluster).
+ * @note Results are read back with bfs_dist_of() and bfs_parent until the next call.
+ */
+static void cluster_bfs(hierarchy *h, int source, int target) {
+    int c = h->cluster_of[source];
+    uint32_t gen = ++h->bfs_gen;
+    int head = 0, tail = 0;
+
+    h->bfs_seen[source] = gen;
+    h->bfs_dist[source] = 0;
+    h->bfs_parent[source] = -1;
+    h->queue[tail++] = source;
+    while (head < tail) {
+        int x = h->queue[head++];
+        if (x == target) return;
+        for (graph *p = h->g[x]; p != NULL; p = p->next) {
+            int y = p->x;
+            if (h->cluster_of[y] != c || h->blocked[y] || h->bfs_seen[y] == gen) continue;
+            h->bfs_seen[y] = gen;
+            h->bfs_dist[y] = h->bfs_dist[x] + 1;
+            h->bfs_parent[y] = x;
+            h->queue[tail++] = y;
+        }
+    }
+}
+
+/**
+ * @brief Recomputes the boundary-to-boundary distances of a cluster with the current obstacles.
+ * @note The abstract edges keep only the pairs with no other boundary vertex on a shortest
+ *       path between them; the dropped ones are implied by two shorter edges, so the search
+ *       finds the same distances while relaxing far fewer edges (a few per vertex on maps).
+ */
+static void refresh_cluster(hierarchy *h, int c) {
+    cluster *cl = &h->clusters[c];
+    const int *b = h->boundary + cl->first_boundary;
+    int n = cl->num_boundary;
+    int *d = cl->dist;
+
+    for (int i = 0; i < n; i++) {
+        int *row = d + (long)i * n;
+        if (h->blocked[b[i]]) {
+            for (int j = 0; j < n; j++) row[j] = -1;
+            continue;
+        }
+        cluster_bfs(h, b[i], -1);
+        for (int j = 0; j < n; j++) row[j] = bfs_dist_of(h, b[j]);
+    }
+
+    int edges = 0;
+    for (int i = 0; i < n; i++) {
+        cl->edge_first[i] = edges;
+        const int *row = d + (long)i * n;
+        for (int j = 0; j < n; j++) {
+            if (row[j] <= 0) continue;
+            int implied = 0;
+            for (int k = 0; k < n && !implied; k++) {
+                int dk = d[(long)k * n + j];
+                implied = row[k] > 0 && dk > 0 && row[k] + dk == row[j];
+            }
+            if (implied) continue;
+            cl->edge_to[edges] = cl->first_boundary + j;
+            cl->edge_cost[edges] = row[j];
+            edges++;
+        }
+    }
+    cl->edge_first[n] = edges;
+    cl->dirty = 0;
+    h->stats.rebuilds++;
+}
+
+// Brings the distance tables of the clusters touched by obstacle moves up to date
+static void refresh_dirty_clusters(hierarchy *h) {
+    for (int i = 0; i < h->num_dirty; i++) refresh_cluster(h, h->dirty_list[i]);
+    h->num_dirty = 0;
+}
+
+/**
+ * @brief Partitions the graph into clusters and precomputes their boundary distances.
+ * @param obstacles 1 for the vertices blocked by an obstacle (may be NULL).
+ * @param cluster_size Maximum number of vertices per cluster.
+ * @note Clusters are grown by BFS from the lowest unassigned vertex, so they are connected.
+ *       A vertex is a boundary vertex if it has a neighbor in another cluster; the boundary
+ *       vertices are the nodes of the abstract graph.
+ */
+hierarchy *hierarchy_build(graph **g, int v, const int *obstacles, int cluster_size) {
+    hierarchy *h = calloc(1, sizeof(hierarchy));
+    h->g = g;
+    h->v = v;
+    h->cluster_of = malloc((v + 1) * sizeof(int));
+    h->members = malloc((v + 1) * sizeof(int));
+    h->boundary = malloc((v + 1) * sizeof(int));
+    h->abstract_id = malloc((v + 1) * sizeof(int));
+    h->blocked = calloc(v + 1, 1);
+    for (int i = 0; i < v && obstacles; i++) h->blocked[i] = obstacles[i] != 0;
+    h->bfs_seen = calloc(v + 1, sizeof(uint32_t));
+    h->bfs_dist = malloc((v + 1) * sizeof(int));
+    h->bfs_parent = malloc((v + 1) * sizeof(int));
+    h->queue = malloc((v + 1) * sizeof(int));
+    h->clusters = malloc((v + 1) * sizeof(cluster));
+    if (cluster_size < 1) cluster_size = 1;
+
+    // Grow the clusters
+    for (int i = 0; i < v; i++) h->cluster_of[i] = -1;
+    int assigned = 0;
+    for (int seed = 0; seed < v; seed++) {
+        if (h->cluster_of[seed] >= 0) continue;
+        int c = h->num_clusters++;
+        cluster *cl = &h->clusters[c];
+        cl->first_member = assigned;
+        cl->num_members = 0;
+
+        h->cluster_of[seed] = c;
+        h->members[assigned++] = seed;
+        cl->num_members++;
+        for (int head = cl->first_member; head < assigned && cl->num_members < cluster_size; head++) {
+            for (graph *p = g[h->members[head]]; p != NULL && cl->num_members < cluster_size; p = p->next) {
+                if (h->cluster_of[p->x] >= 0) continue;
+                h->cluster_of[p->x] = c;
+                h->members[assigned++] = p->x;
+                cl->num_members++;
+            }
+        }
+    }
+    h->clusters = realloc(h->clusters, (h->num_clusters + 1) * sizeof(cluster));
+
+    // Collect the boundary vertices of each cluster
+    int num_boundary = 0;
+    for (int c = 0; c < h->num_clusters; c++) {
+        cluster *cl = &h->clusters[c];
+        cl->first_boundary = num_boundary;
+        cl->num_boundary = 0;
+        for (int k = 0; k < cl->num_members; k++) {
+            int x = h->members[cl->first_member + k];
+            h->abstract_id[x] = -1;
+            for (graph *p = g[x]; p != NULL; p = p->next) {
+                if (h->cluster_of[p->x] != c) {
+                    h->abstract_id[x] = num_boundary;
+                    h->boundary[num_boundary++] = x;
+                    cl->num_boundary++;
+                    break;
+                }
+            }
+        }
+        if (cl->num_boundary > h->max_boundary) h->max_boundary = cl->num_boundary;
+        long pairs = (long)cl->num_boundary * cl->num_boundary + 1;
+        cl->dist = malloc(pairs * sizeof(int));
+        cl->edge_first = malloc((cl->num_boundary + 1) * sizeof(int));
+        cl->edge_to = malloc(pairs * sizeof(int));
+        cl->edge_cost = malloc(pairs * sizeof(int));
+        cl->edge_first[0] = 0;
+        cl->dirty = 0;
+    }
+    h->num_boundary = num_boundary;
+    h->goal_cost = malloc((h->max_boundary + 1) * sizeof(int));
+    h->dirty_list = malloc((h->num_clusters + 1) * sizeof(int));
+
+    // Edges between clusters, in abstract node ids so the search never walks the adjacency list
+    int inter_edges = 0;
+    h->inter_first = malloc((num_boundary + 1) * sizeof(int));
+    for (int a = 0; a < num_boundary; a++) {
+        int x = h->boundary[a];
+        for (graph *p = g[x]; p != NULL; p = p->next) {
+            if (h->cluster_of[p->x] != h->cluster_of[x]) inter_edges++;
+        }
+    }
+    h->inter_to = malloc((inter_edges + 1) * sizeof(int));
+    inter_edges = 0;
+    for (int a = 0; a < num_boundary; a++) {
+        int x = h->boundary[a];
+        h->inter_first[a] = inter_edges;
+        for (graph *p = g[x]; p != NULL; p = p->next) {
+            if (h->cluster_of[p->x] != h->cluster_of[x]) h->inter_to[inter_edges++] = h->abstract_id[p->x];
+        }
+    }
+    h->inter_first[num_boundary] = inter_edges;
+
+    h->search_seen = calloc(num_boundary + 1, sizeof(uint32_t));
+    h->search_closed = calloc(num_boundary + 1, sizeof(uint32_t));
+    h->search_dist = malloc((num_boundary + 1) * sizeof(int));
+    h->search_parent = malloc((num_boundary + 1) * sizeof(int));
+    h->waypoints = malloc((num_boundary + 1) * sizeof(int));
+
+    // A cluster without boundary vertices has an empty table (see hier_set_obstacle())
+    for (int c = 0; c < h->num_clusters; c++) {
+        if (h->clusters[c].num_boundary > 0) refresh_cluster(h, c);
+    }
+    h->stats.clusters = h->num_clusters;
+    h->stats.boundary_vertices = num_boundary;
+    return h;
+}
+
+void hierarchy_free(hierarchy *h) {
+    for (int c = 0; c < h->num_clusters; c++) {
+        free(h->clusters[c].dist);
+        free(h->clusters[c].edge_first);
+        free(h->clusters[c].edge_to);
+        free(h->clusters[c].edge_cost);
+    }
+    free(h->clusters);
+    free(h->cluster_of);
+    free(h->members);
+    free(h->boundary);
+    free(h->abstract_id);
+    free(h->inter_first);
+    free(h->inter_to);
+    free(h->blocked);
+    free(h->dirty_list);
+    free(h->goal_cost);
+    free(h->bfs_seen);
+    free(h->bfs_dist);
+    free(h->bfs_parent);
+    free(h->queue);
+    free(h->search_seen);
+    free(h->search_closed);
+    free(h->search_dist);
+    free(h->search_parent);
+    free(h->waypoints);
+    free(h);
+}
+
+/**
+ * @brief Places (blocked = 1) or removes (blocked = 0) an obstacle on vertex x.
+ * @note Only the cluster containing x is marked dirty; its distance table is recomputed
+ *       lazily by the next hier_plan(), once however many obstacles moved inside it.
+ *       Edges between clusters are checked against the obstacles at search time and
+ *       never need a rebuild. Neither does a cluster without boundary vertices: it has
+ *       no table, and the start and goal are attached by a BFS at query time.
+ */
+void hier_set_obstacle(hierarchy *h, int x, int blocked) {
+    if (h->blocked[x] == blocked) return;
+    h->blocked[x] = blocked;
+
+    int c = h->cluster_of[x];
+    if (!h->clusters[c].dirty && h->clusters[c].num_boundary > 0) {
+        h->clusters[c].dirty = 1;
+        h->dirty_list[h->num_dirty++] = c;
+    }
+}
+
+/* ---------------------------------- Planning ---------------------------------- */
+
+static void abstract_relax(hierarchy *h, abstract_heap *pq, int node, int dist, int from) {
+    uint32_t gen = h->search_gen;
+    if (h->search_closed[node] == gen) return;
+    if (h->search_seen[node] != gen || dist < h->search_dist[node]) {
+        h->search_seen[node] = gen;
+        h->search_dist[node] = dist;
+        h->search_parent[node] = from;
+        abstract_push(pq, dist, node);
+    }
+}
+
+// Appends the in-cluster shortest path from u (excluded) to w (included) to path
+static int refine_segment(hierarchy *h, int u, int w, int *path, int length) {
+    cluster_bfs(h, u, w);
+    int hops = h->bfs_dist[w];
+    int k = length + hops;
+    for (int x = w; x != u; x = h->bfs_parent[x]) path[--k] = x;
+    h->stats.refined++;
+    return length + hops;
+}
+
+/**
+ * @brief Shortest path from start to goal with the obstacles frozen where they are.
+ * @return Full vertex path, or {NULL, 0} if the obstacles cut the goal off.
+ * @note Dirty clusters are refreshed first. The search then runs on the abstract graph:
+ *       boundary vertices linked by the cached in-cluster distances and by the original
+ *       edges between clusters, plus the start and goal attached through a BFS inside their
+ *       own clusters. Only the cluster crossings of the resulting abstract path are refined
+ *       into vertices. The cached distances are exact, so the path is as short as a flat
+ *       BFS over the whole graph would find.
+ */
+path_result hier_plan(hierarchy *h, int start, int goal) {
+    path_result result = {NULL, 0};
+    int goal_node = h->num_boundary;
+    if (h->blocked[start] || h->blocked[goal]) return result;
+    refresh_dirty_clusters(h);
+
+    abstract_heap pq = {NULL, 0, 0};
+    h->search_gen++;
+
+    // Attach the start to the boundary of its cluster (and to the goal if they share one)
+    int cs = h->cluster_of[start], cg = h->cluster_of[goal];
+    const cluster *start_cl = &h->clusters[cs];
+    const cluster *goal_cl = &h->clusters[cg];
+    cluster_bfs(h, start, -1);
+    for (int a = start_cl->first_boundary; a < start_cl->first_boundary + start_cl->num_boundary; a++) {
+        int d = bfs_dist_of(h, h->boundary[a]);
+        if (d >= 0) abstract_relax(h, &pq, a, d, -1);
+    }
+    if (cs == cg && bfs_dist_of(h, goal) >= 0) abstract_relax(h, &pq, goal_node, bfs_dist_of(h, goal), -1);
+
+    // Attach the goal's cluster boundary to the goal (the graph is undirected)
+    cluster_bfs(h, goal, -1);
+    for (int j = 0; j < goal_cl->num_boundary; j++) {
+        h->goal_cost[j] = bfs_dist_of(h, h->boundary[goal_cl->first_boundary + j]);
+    }
+
+    int found = 0;
+    while (pq.size > 0) {
+        abstract_entry e = abstract_pop(&pq);
+        int a = e.node;
+        if (h->search_closed[a] == h->search_gen) continue;
+        h->search_closed[a] = h->search_gen;
+        h->stats.abstract_expansions++;
+        if (a == goal_node) {
+            found = 1;
+            break;
+        }
+
+        int c = h->cluster_of[h->boundary[a]];
+        const cluster *cl = &h->clusters[c];
+        for (int k = cl->edge_first[a - cl->first_boundary]; k < cl->edge_first[a - cl->first_boundary + 1]; k++) {
+            abstract_relax(h, &pq, cl->edge_to[k], e.dist + cl->edge_cost[k], a);
+        }
+        for (int k = h->inter_first[a]; k < h->inter_first[a + 1]; k++) {
+            int b = h->inter_to[k];
+            if (!h->blocked[h->boundary[b]]) abstract_relax(h, &pq, b, e.dist + 1, a);
+        }
+        if (c == cg && h->goal_cost[a - cl->first_boundary] >= 0) {
+            abstract_relax(h, &pq, goal_node, e.dist + h->goal_cost[a - cl->first_boundary], a);
+        }
+    }
+    free(pq.nodes);
+    if (!found) return result;
+
+    // Abstract path, goal first
+    int num_waypoints = 0;
+    for (int a = h->search_parent[goal_node]; a != -1; a = h->search_parent[a]) h->waypoints[num_waypoints++] = a;
+
+    int length = h->search_dist[goal_node] + 1;
+    result.path = malloc(length * sizeof(int));
+    result.path[0] = start;
+    int filled = 1, prev = start;
+    for (int k = num_waypoints; k >= 0; k--) {
+        int w = k > 0 ? h->boundary[h->waypoints[k - 1]] : goal;
+        if (w == prev) continue;
+        if (h->cluster_of[w] == h->cluster_of[prev]) {
+            filled = refine_segment(h, prev, w, result.path, filled);
+        } else {
+            result.path[filled++] = w; // Edge between clusters
+        }
+        prev = w;
+    }
+    result.length = filled;
+    return result;
+}
+
+/* ---------------------------------- Navigation ---------------------------------- */
+
+// Moves one random obstacle to a random free neighbor other than the robot's vertex
+static void move_random_obstacle(hierarchy *h, int *obstacles, int num_obstacles, int robot, rng_stream *rng) {
+    if (num_obstacles == 0) return;
+
+    int k = rng_below(rng, num_obstacles);
+    int x = obstacles[k], n = 0;
+    for (graph *p = h->g[x]; p != NULL; p = p->next) {
+        if (!h->blocked[p->x] && p->x != robot) n++;
+    }
+    if (n == 0) return;
+
+    int target = rng_below(rng, n);
+    for (graph *p = h->g[x]; p != NULL; p = p->next) {
+        if (!h->blocked[p->x] && p->x != robot && target-- == 0) {
+            hier_set_obstacle(h, x, 0);
+            hier_set_obstacle(h, p->x, 1);
+            obstacles[k] = p->x;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Drives the robot from start to goal while the obstacles move.
+ * @param obstacles Vertices of the obstacles; updated in place as they move.
+ * @param max_steps Give up after this many steps.
+ * @return The robot vertex after every step (the start included), or {NULL, 0} if the
+ *         goal was not reached within max_steps.
+ * @note Same model as grid_navigate(): each step is a robot move or a move of one random
+ *       obstacle (50% each). The robot follows its current plan and replans with
+ *       hier_plan() only when an obstacle blocks the next vertex; by then only the
+ *       clusters the obstacles moved in are rebuilt.
+ */
+path_result hier_navigate(hierarchy *h, int start, int goal, int *obstacles, int num_obstacles, int max_steps,
+                          rng_stream *rng) {
+    path_result result = {NULL, 0};
+    int length = 0, robot = start;
+
+    for (int i = 0; i < num_obstacles; i++) hier_set_obstacle(h, obstacles[i], 1);
+    h->stats.steps = 0;
+    h->stats.replans = 1;
+    path_result plan = hier_plan(h, robot, goal);
+    int plan_index = 0;
+
+    // The trace grows with the run instead of being sized for max_steps up front
+    int capacity = plan.path ? 2 * plan.length : 256;
+    int *trace = malloc(capacity * sizeof(int));
+    trace[length++] = robot;
+    while (robot != goal && h->stats.steps < max_steps) {
+        if (rng_below(rng, 2) == 0) { // Robot move
+            if (!plan.path || h->blocked[plan.path[plan_index + 1]]) {
+                free(plan.path);
+                plan = hier_plan(h, robot, goal);
+                plan_index = 0;
+                h->stats.replans++;
+            }
+            if (plan.path) robot = plan.path[++plan_index]; // Otherwise wait for the way to clear
+        } else { // Obstacle move
+            move_random_obstacle(h, obstacles, num_obstacles, robot, rng);
+        }
+        h->stats.steps++;
+        if (length == capacity) {
+            capacity *= 2;
+            trace = realloc(trace, capacity * sizeof(int));
+        }
+        trace[length++] = robot;
+    }
+    free(plan.path);
+
+    if (robot == goal) {
+        result.path = trace;
+        result.length = length;
+    } else {
+        free(trace);
+    }
+    return result;
+}
+
+// Cluster counts and the work done by the abstract searches
+void out_hier_stats(out_writer *w, int format, const hier_stats *s) {
+    out_field fields[] = {
+        {"clusters",            "Hierarchy: ",                   OUT_FIELD_INT,  s->clusters, 0},
+        {"boundary",            " clusters, ",                   OUT_FIELD_INT,  s->boundary_vertices, 0},
+        {"rebuilds",            " boundary vertices, ",          OUT_FIELD_LONG, s->rebuilds, 0},
+        {"replans",             " cluster rebuilds\nReplans: ",  OUT_FIELD_INT,  s->replans, 0},
+        {"abstract_expansions", ", abstract nodes expanded: ",   OUT_FIELD_LONG, s->abstract_expansions, 0},
+        {"refined",             ", cluster crossings refined: ", OUT_FIELD_LONG, s->refined, 0},
+    };
+    out_stats(w, format, REC_HIER_STATS, "hierarchy", fields, sizeof(fields) / sizeof(fields[0]), "\n");
+}
@@ -0,0 +1,72 @@
+#ifndef HIERARCHY_H
+#define HIERARCHY_H
+
+#include <stdint.h>
+#include "dijkstras.h"
+#include "output.h"
+
+// Group of nearby vertices; its boundary vertices are the nodes of the abstract graph
+typedef struct {
+    int first_member;    /**< Start of the cluster's slice of hierarchy.members. */
+    int num_members;     /**< Number of vertices in the cluster. */
+    int first_boundary;  /**< Start of the cluster's slice of hierarchy.boundary. */
+    int num_boundary;    /**< Vertices with a neighbor in another cluster. */
+    int *dist;           /**< num_boundary x num_boundary hops inside the cluster, -1 if unreachable. */
+    int *edge_first;     /**< Abstract edges of boundary vertex i are edge_first[i] .. edge_first[i + 1] - 1. */
+    int *edge_to;        /**< Abstract node the edge leads to. */
+    int *edge_cost;      /**< Hops of the edge. */
+    int dirty;           /**< 1 if an obstacle moved in the cluster since dist was computed. */
+} cluster;
+
+// Counters of the hierarchy and of the queries run on it
+typedef struct {
+    int clusters;                  /**< Number of clusters. */
+    int boundary_vertices;         /**< Nodes of the abstract graph. */
+    long long rebuilds;            /**< Cluster distance tables computed (initial build included). */
+    long long abstract_expansions; /**< Nodes expanded by the abstract searches. */
+    long long refined;             /**< Cluster crossings expanded into vertex paths. */
+    int replans;                   /**< Plans made while navigating. */
+    int steps;                     /**< Robot and obstacle moves while navigating. */
+} hier_stats;
+
+// Cluster abstraction of a graph with obstacles that block vertices
+typedef struct {
+    graph **g;               /**< Adjacency list (undirected). */
+    int v;                   /**< Number of vertices. */
+    int num_clusters;        /**< Number of clusters. */
+    cluster *clusters;       /**< Clusters. */
+    int *cluster_of;         /**< Cluster of each vertex. */
+    int *members;            /**< Vertices grouped by cluster. */
+    int num_boundary;        /**< Nodes of the abstract graph; node num_boundary stands for the goal. */
+    int *boundary;           /**< Vertex of each abstract node, grouped by cluster. */
+    int *abstract_id;        /**< Abstract node of each vertex, -1 if interior. */
+    int *inter_first;        /**< Edges of node a to other clusters are inter_to[inter_first[a] .. inter_first[a + 1] - 1]. */
+    int *inter_to;           /**< Abstract node across each edge between clusters. */
+    unsigned char *blocked;  /**< 1 where an obstacle stands. */
+    int *dirty_list;         /**< Clusters waiting for their distances to be recomputed. */
+    int num_dirty;           /**< Length of dirty_list. */
+    int max_boundary;        /**< Largest num_boundary of a cluster, sizes goal_cost. */
+    int *goal_cost;          /**< Query scratch: hops from each boundary vertex of the goal's cluster to the goal. */
+    uint32_t bfs_gen;        /**< Generation of the cluster BFS scratch. */
+    uint32_t *bfs_seen;      /**< Generation in which bfs_dist was set. */
+    int *bfs_dist;           /**< Hops from the BFS source. */
+    int *bfs_parent;         /**< Previous vertex on the BFS tree. */
+    int *queue;              /**< BFS queue. */
+    uint32_t search_gen;     /**< Generation of the abstract search scratch. */
+    uint32_t *search_seen;   /**< Generation in which search_dist was set. */
+    uint32_t *search_closed; /**< Generation in which the node was expanded. */
+    int *search_dist;        /**< Cost of each abstract node from the start. */
+    int *search_parent;      /**< Previous abstract node, -1 for the start. */
+    int *waypoints;          /**< Abstract path of the last search, goal first. */
+    hier_stats stats;        /**< Counters. */
+} hierarchy;
+
+hierarchy *hierarchy_build(graph **g, int v, const int *obstacles, int cluster_size);
+void hierarchy_free(hierarchy *h);
+void hier_set_obstacle(hierarchy *h, int x, int blocked);
+path_result hier_plan(hierarchy *h, int start, int goal);
+path_result hier_navigate(hierarchy *h, int start, int goal, int *obstacles, int num_obstacles, int max_steps,
+                          rng_stream *rng);
+void out_hier_stats(out_writer *w, int format, const hier_stats *s);
+
+#endif
@@ -1,10 +1,42 @@
 #include<stdio.h>
 #include<stdlib.h>
+#include<string.h>
 #include "dijkstras.h"
 #include "dfs_pathfinder.h"
+#include "output.h"
+#include "montecarlo.h"
+#include "msbfs.h"
+#include "reorder.h"
+#include "cache.h"
+#include "grid.h"
+#include "hierarchy.h"
 #include <time.h>
 
 int IS_DIJKSTRAS = 1;
+int IS_QUIET = 0;                  // 1 to skip the graph dump and DFS traces
+int OUTPUT_FORMAT = OUTPUT_TEXT;   // OUTPUT_TEXT, OUTPUT_NDJSON or OUTPUT_BINARY
+int IS_SIMULATION = 0;             // 1 to run SIM_TRIALS seeded trials instead of a single query
+int SIM_TRIALS = 10000;
+int SIM_THREADS = 0;               // 0 = one thread per CPU
+uint64_t SIM_SEED = 0;             // Seed of the trial streams, 0 = time-based
+int IS_DISTANCE_TABLE = 0;         // 1 to build the all-pairs hop table and compare against repeated BFS
+int REORDER_MODE = REORDER_NONE;   // REORDER_NONE, REORDER_BFS or REORDER_RCM
+int USE_CACHE = 0;                 // 1 to answer a stream of queries through the LRU result cache
+int CACHE_ENTRIES = 4096;
+long CACHE_BYTES = 16L << 20;
+int CACHE_QUERIES = 1000;          // Queries answered through the cache, the first is the one in config.in
+int CACHE_QUERY_PAIRS = 64;        // Distinct (start, goal) pairs the other queries are drawn from
+int DFS_THREADS = 1;               // 1 for the sequential DFS, otherwise a work-stealing pool (0 = one thread per CPU)
+int TICK_EXPANSIONS = 0;           // >0 to run the query in ticks of at most this many expansions (DFS: search nodes)
+long TICK_NANOS = 0;               // >0 to also cap each tick at this many nanoseconds
+int IS_GRID = 0;                   // 1 to plan on the occupancy grid in grid.in instead of config.in
+int GRID_MAX_STEPS = 1000000;
+int IS_HIERARCHICAL = 0;           // 1 to navigate config.in with the cluster hierarchy (large maps)
+int CLUSTER_SIZE = 64;             // Maximum vertices per cluster of the hierarchy
+int HIER_MAX_STEPS = 1000000;
+
+static out_writer out;
+static vertex_order *order = NULL; // Set when the vertices are renumbered
 
 //Structure for the graph
 typedef struct node{
@@ -17,6 +49,18 @@ void viewList(graph **, int);
 void deleteGraph(graph **, int);
 int *readObstacles(int, int *, int *, int *);
 int *readObstaclesDFS(int, int *, int *, int *);
+struct Graph *createDFSGraph(int *, int *);
+void runSimulation(graph **, int, int, int, int *, int);
+void runDistanceTable(graph **, int);
+void runGrid(void);
+void runHierarchical(graph **, int, int, int, int *);
+path_result runTicked(graph **, int, int, int, int *);
+path_result runTickedDFS(struct Graph *, int, int, int *, int, int *, rng_stream *, struct DFSStats *);
+path_result runCachedQueries(graph **, struct Graph *, int, int, int, int *, int, int *);
+void applyReordering(graph ***, int, int *, int *, int *);
+int internalId(int);
+int originalId(int);
+void translatePath(path_result *);
 
 void printObstacles(int *, int);
 void printStartGoal(int, int);
@@ -29,62 +73,83 @@ int main() {
     float time_before, time_after, time_elapsed;
     srand(time(NULL)); 
   
+    out_init(&out, stdout);
+    if (OUTPUT_FORMAT == OUTPUT_BINARY) out_binary_header(&out);
+    if (IS_GRID){
+        runGrid();
+        out_flush(&out);
+        return 0;
+    }
+
     g = createAdjList(&v, &e);
     int *obstacles = readObstacles(v, &num_obstacles, &start, &goal);
     
 
-    viewList(g, v);
+    if (!IS_QUIET) viewList(g, v);
     printObstacles(obstacles, v);
     printStartGoal(start, goal);
+    if (REORDER_MODE != REORDER_NONE) applyReordering(&g, v, obstacles, &start, &goal);
+    out_flush(&out);
 
     time_before = clock();
 
-    if (IS_DIJKSTRAS){
-        path_result result = dijkstra(g, v, start, goal, obstacles, num_obstacles);
-        if (result.path) {
-            printf("Path found: ");
-            for (int i = 0; i < result.length; i++) {
-                printf("%d ", result.path[i]);
-            }
-            printf("\nNumber of steps: %d\n", result.length - 1);
-            free(result.path);
+    if (IS_DISTANCE_TABLE){
+        runDistanceTable(g, v);
+    } else if (IS_HIERARCHICAL){
+        runHierarchical(g, v, start, goal, obstacles);
+    } else if (IS_SIMULATION){
+        runSimulation(g, v, start, goal, obstacles, num_obstacles);
+    } else if (IS_DIJKSTRAS){
+        path_result result;
+        if (USE_CACHE){
+            int steps;
+            result = runCachedQueries(g, NULL, v, start, goal, obstacles, num_obstacles, &steps);
+        } else if (TICK_EXPANSIONS > 0 || TICK_NANOS > 0){
+            result = runTicked(g, v, start, goal, obstacles);
         } else {
-            printf("No path found\n");
+            result = dijkstra(g, v, start, goal, obstacles, num_obstacles);
         }
+        translatePath(&result);
+        time_after = clock();
+        time_elapsed = (float)(time_after - time_before) / CLOCKS_PER_SEC;
+        out_result(&out, OUTPUT_FORMAT, PLANNER_DIJKSTRA, result.path, result.length,
+                   result.length - 1, time_elapsed);
+        free(result.path);
     } else {
-        struct Graph* dfsGraph = createGraph(v);
-        FILE *fp = fopen("config.in", "r");
-        if (fp == NULL) {
-            printf("Error opening config.in\n");
-            exit(1);
-        }
-
-        fscanf(fp, "%d", &v);  // Number of vertices
-        fscanf(fp, "%d", &e);  // Number of edges
-
-        for (int i = 0; i < e; i++) {
-            int src, dest;
-            fscanf(fp, "%d %d", &src, &dest);
-            addEdge(dfsGraph, src, dest);
-        }
-
-        fclose(fp);
-
+        struct Graph* dfsGraph = createDFSGraph(&v, &e);
 
-
-        printf("\n--- DFS Pathfinding ---\n");
+        if (OUTPUT_FORMAT == OUTPUT_TEXT) printf("\n--- DFS Pathfinding ---\n");
+        free(obstacles);
         obstacles = readObstaclesDFS(v, &num_obstacles, &start, &goal);
-        findShortestPathDFS(dfsGraph, start, goal, obstacles, num_obstacles);
+        int steps;
+        rng_stream rng;
+        rng_init(&rng, (uint64_t)time(NULL), 0);
+        struct DFSStats stats = {0};
+        path_result result;
+        if (USE_CACHE){
+            result = runCachedQueries(NULL, dfsGraph, v, start, goal, obstacles, num_obstacles, &steps);
+        } else if (TICK_EXPANSIONS > 0 || TICK_NANOS > 0){
+            result = runTickedDFS(dfsGraph, start, goal, obstacles, num_obstacles, &steps, &rng, &stats);
+        } else if (DFS_THREADS == 1){
+            result = planShortestPathDFS(dfsGraph, start, goal, obstacles, num_obstacles, &steps, &rng, &stats);
+        } else {
+            result = planShortestPathDFSParallel(dfsGraph, start, goal, obstacles, num_obstacles, &steps, &rng,
+                                                 DFS_THREADS, &stats);
+        }
+        translatePath(&result);
+        time_after = clock();
+        time_elapsed = (float)(time_after - time_before) / CLOCKS_PER_SEC;
+        out_result(&out, OUTPUT_FORMAT, PLANNER_DFS, result.path, result.length, steps, time_elapsed);
+        if (!USE_CACHE) out_dfs_stats(&out, OUTPUT_FORMAT, &stats); // The cache printed its own counters
+        free(result.path);
+        freeGraph(dfsGraph);
     }
 
-  
-    time_after = clock();
-    time_elapsed = (float)(time_after - time_before) / CLOCKS_PER_SEC;
-    printf("Time taken: %f seconds\n", time_elapsed);
-
+    out_flush(&out);
 
     deleteGraph(g, v);
     free(obstacles);
+    if (order) free_vertex_order(order);
     return 0;
 }
 
@@ -123,20 +188,399 @@ graph **createAdjList(int *v, int *e){
     return G;
 }
 
+//Reads the graph from a file into the adjacency list used by the DFS
+struct Graph *createDFSGraph(int *v, int *e){
+    FILE *fp = fopen("config.in", "r");
+    if (fp == NULL) {
+        printf("Error opening config.in\n");
+        exit(1);
+    }
+
+    fscanf(fp, "%d", v);  // Number of vertices
+    fscanf(fp, "%d", e);  // Number of edges
+
+    struct Graph* dfsGraph = createGraph(*v);
+    for (int i = 0; i < *e; i++) {
+        int src, dest;
+        fscanf(fp, "%d %d", &src, &dest);
+        addEdge(dfsGraph, internalId(src), internalId(dest));
+    }
+
+    fclose(fp);
+    return dfsGraph;
+}
+
+//Runs SIM_TRIALS independent trials of the configured query and prints their distribution
+void runSimulation(graph **g, int v, int start, int goal, int *obstacles, int num_obstacles){
+    sim_scenario scenario = {PLANNER_DIJKSTRA, g, NULL, v, start, goal, obstacles, num_obstacles};
+    int *obstacle_list = NULL;
+    sim_report report;
+
+    IS_QUIET = 1; // Trials run concurrently, their traces would interleave
+    if (!IS_DIJKSTRAS){
+        int e;
+        scenario.planner = PLANNER_DFS;
+        scenario.dfs_graph = createDFSGraph(&v, &e);
+        obstacle_list = readObstaclesDFS(v, &num_obstacles, &start, &goal);
+        scenario.obstacles = obstacle_list;
+    }
+
+    uint64_t seed = SIM_SEED ? SIM_SEED : (uint64_t)time(NULL);
+    run_simulation(&scenario, SIM_TRIALS, SIM_THREADS, seed, &report);
+    out_sim_report(&out, OUTPUT_FORMAT, &report);
+    free(obstacle_list);
+    if (scenario.dfs_graph) freeGraph(scenario.dfs_graph);
+}
+
+//Builds the all-pairs hop table with the multi-source BFS and times it against one BFS per source
+void runDistanceTable(graph **g, int v){
+    clock_t t0 = clock();
+    distance_table *table = build_all_pairs_table(g, v);
+    double batched = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    // Same table built with one BFS per source
+    int *rows = malloc(sizeof(int) * ((long)v * v + 1));
+    t0 = clock();
+    for (int s = 0; s < v; s++){
+        bfs_single(g, v, s, rows + (long)s * v);
+    }
+    double repeated = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    int mismatches = 0;
+    for (int s = 0; s < v; s++){
+        for (int x = 0; x < v; x++){
+            if (rows[(long)s * v + x] != all_pairs_distance(table, s, x)) mismatches++;
+        }
+    }
+    free(rows);
+
+    if (OUTPUT_FORMAT == OUTPUT_NDJSON){
+        out_str(&out, "{\"type\":\"distance_table\",\"sources\":");
+        out_int(&out, v);
+        out_str(&out, ",\"batch\":");
+        out_int(&out, MSBFS_BATCH);
+        out_str(&out, ",\"msbfs_seconds\":");
+        out_double(&out, batched);
+        out_str(&out, ",\"bfs_seconds\":");
+        out_double(&out, repeated);
+        out_str(&out, ",\"mismatches\":");
+        out_int(&out, mismatches);
+        out_str(&out, "}\n");
+    } else if (OUTPUT_FORMAT == OUTPUT_TEXT){
+        if (!IS_QUIET){
+            int *row = malloc(sizeof(int) * (v + 1));
+            for (int s = 0; s < v; s++){
+                for (int x = 0; x < v; x++) row[x] = all_pairs_distance(table, internalId(s), internalId(x));
+                out_adjacency(&out, OUTPUT_TEXT, s, row, v);
+            }
+            free(row);
+        }
+        out_str(&out, "\n--- All-Pairs Distance Table ---\nMulti-source BFS (");
+        out_int(&out, MSBFS_BATCH);
+        out_str(&out, " sources per batch): ");
+        out_double(&out, batched);
+        out_str(&out, " seconds\nRepeated single-source BFS: ");
+        out_double(&out, repeated);
+        out_str(&out, " seconds\nMismatches: ");
+        out_int(&out, mismatches);
+        out_char(&out, '\n');
+    }
+
+    free_distance_table(table);
+}
+
+//Runs the Dijkstra query as a resumable search, one budgeted step per tick, and reports the worst tick.
+path_result runTicked(graph **g, int v, int start, int goal, int *obstacles){
+    rng_stream rng;
+    rng_init(&rng, (uint64_t)time(NULL), 0);
+    dijkstra_search *search = dijkstra_search_create(g, v, start, goal, obstacles, &rng);
+
+    int ticks = 0;
+    double worst = 0.0;
+    int status = SEARCH_RUNNING;
+    while (status == SEARCH_RUNNING){
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        status = dijkstra_search_step(search, TICK_EXPANSIONS, TICK_NANOS);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double tick = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        if (tick > worst) worst = tick;
+        ticks++;
+    }
+
+    if (OUTPUT_FORMAT == OUTPUT_TEXT){
+        out_int(&out, ticks);
+        out_str(&out, " ticks, ");
+        out_long(&out, dijkstra_search_expansions(search));
+        out_str(&out, " expansions, longest tick ");
+        out_double(&out, worst * 1e6);
+        out_str(&out, " us\n");
+    }
+
+    path_result result = {NULL, 0};
+    if (status == SEARCH_FOUND) result = dijkstra_search_best_path(search);
+    dijkstra_search_free(search);
+    return result;
+}
+
+//Same as runTicked() for the DFS planner; the best path so far could be read after any tick
+path_result runTickedDFS(struct Graph *g, int start, int goal, int *obstacles, int num_obstacles, int *steps,
+                         rng_stream *rng, struct DFSStats *stats){
+    struct DFSSearch *search = dfsSearchCreate(g, start, goal, obstacles, num_obstacles, rng);
+
+    int ticks = 0;
+    double worst = 0.0;
+    int status = SEARCH_RUNNING;
+    while (status == SEARCH_RUNNING){
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        status = dfsSearchStep(search, TICK_EXPANSIONS, TICK_NANOS);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double tick = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        if (tick > worst) worst = tick;
+        ticks++;
+    }
+
+    *stats = dfsSearchStats(search);
+    if (OUTPUT_FORMAT == OUTPUT_TEXT){
+        out_int(&out, ticks);
+        out_str(&out, " ticks, ");
+        out_long(&out, stats->nodes);
+        out_str(&out, " nodes, longest tick ");
+        out_double(&out, worst * 1e6);
+        out_str(&out, " us\n");
+    }
+
+    path_result result = dfsSearchBestPath(search, steps);
+    dfsSearchFree(search);
+    return result;
+}
+
+//Drives the robot across the grid map in grid.in with jump point search, replanning when obstacles block it.
+//Cells are reported as y * width + x.
+void runGrid(void){
+    int start, goal;
+    grid_map *m = read_grid("grid.in", &start, &goal);
+
+    if (OUTPUT_FORMAT == OUTPUT_TEXT){
+        out_str(&out, "Grid: ");
+        out_int(&out, m->width);
+        out_char(&out, 'x');
+        out_int(&out, m->height);
+        out_str(&out, ", ");
+        out_int(&out, m->connectivity);
+        out_str(&out, "-connected, ");
+        out_int(&out, m->num_obstacles);
+        out_str(&out, " moving obstacles\n");
+    }
+    out_obstacles(&out, OUTPUT_FORMAT, m->obstacle_cells, m->num_obstacles);
+    out_query(&out, OUTPUT_FORMAT, start, goal);
+    out_flush(&out);
+
+    rng_stream rng;
+    grid_stats stats;
+    rng_init(&rng, (uint64_t)time(NULL), 0);
+    clock_t t0 = clock();
+    path_result result = grid_navigate(m, start, goal, GRID_MAX_STEPS, &rng, &stats);
+    double seconds = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    if (OUTPUT_FORMAT == OUTPUT_TEXT){
+        out_str(&out, "Replans: ");
+        out_int(&out, stats.replans);
+        out_str(&out, ", jump points expanded: ");
+        out_long(&out, stats.expansions);
+        out_char(&out, '\n');
+    }
+    out_result(&out, OUTPUT_FORMAT, PLANNER_JPS, result.path, result.length, stats.steps, seconds);
+
+    free(result.path);
+    free_grid(m);
+}
+
+//Navigates the query of config.in on a cluster hierarchy: plans on the abstract graph of cluster
+//boundaries and rebuilds only the clusters the obstacles move in
+void runHierarchical(graph **g, int v, int start, int goal, int *obstacles){
+    int num_obstacles = 0;
+    int *cells = malloc(sizeof(int) * (v + 1));
+    for (int i = 0; i < v; i++){
+        if (obstacles[i]) cells[num_obstacles++] = i;
+    }
+
+    clock_t t0 = clock();
+    hierarchy *h = hierarchy_build(g, v, obstacles, CLUSTER_SIZE);
+    double build_seconds = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    rng_stream rng;
+    rng_init(&rng, (uint64_t)time(NULL), 0);
+    t0 = clock();
+    path_result result = hier_navigate(h, start, goal, cells, num_obstacles, HIER_MAX_STEPS, &rng);
+    double seconds = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    if (OUTPUT_FORMAT == OUTPUT_TEXT){
+        out_str(&out, "Hierarchy built in ");
+        out_double(&out, build_seconds);
+        out_str(&out, " s\n");
+    }
+    out_hier_stats(&out, OUTPUT_FORMAT, &h->stats);
+    translatePath(&result);
+    out_result(&out, OUTPUT_FORMAT, PLANNER_HIERARCHICAL, result.path, result.length, h->stats.steps, seconds);
+
+    free(result.path);
+    free(cells);
+    hierarchy_free(h);
+}
+
+//Answers CACHE_QUERIES queries through one result cache and returns the result of the query of config.in.
+//That query comes first; the others are drawn from CACHE_QUERY_PAIRS random (start, goal) pairs with the same
+//obstacles, so repeated pairs hit the cache and the counters show whether its size fits the workload.
+//dfsGraph selects the DFS planner (obstacles is then the list of obstacle vertices), NULL selects Dijkstra.
+path_result runCachedQueries(graph **g, struct Graph *dfsGraph, int v, int start, int goal, int *obstacles,
+                             int num_obstacles, int *steps){
+    path_cache *cache = path_cache_create(v, CACHE_ENTRIES, CACHE_BYTES);
+    rng_stream rng;
+    rng_init(&rng, (uint64_t)time(NULL), 0);
+
+    // Endpoints are drawn among the free vertices
+    int *blocked = calloc(v + 1, sizeof(int));
+    for (int i = 0; i < (dfsGraph ? num_obstacles : v); i++){
+        if (dfsGraph) blocked[obstacles[i]] = 1;
+        else blocked[i] = obstacles[i];
+    }
+    int pairs = CACHE_QUERY_PAIRS > 1 ? CACHE_QUERY_PAIRS : 1;
+    int *ends = malloc(sizeof(int) * 2 * pairs);
+    ends[0] = start;
+    ends[1] = goal;
+    for (int p = 1; p < pairs; p++){
+        for (int k = 0; k < 2; k++){
+            int x = rng_below(&rng, v);
+            for (int tries = 0; blocked[x] && tries < v; tries++) x = rng_below(&rng, v);
+            ends[2 * p + k] = x;
+        }
+    }
+
+    int quiet = IS_QUIET;
+    int *moved = malloc(sizeof(int) * (num_obstacles + 1)); // The DFS moves its obstacles in place
+    path_result first = {NULL, 0};
+    for (int q = 0; q < CACHE_QUERIES || q == 0; q++){
+        int p = q == 0 ? 0 : rng_below(&rng, pairs);
+        int query_steps;
+        path_result r;
+        if (dfsGraph){
+            memcpy(moved, obstacles, sizeof(int) * num_obstacles);
+            r = cached_dfs(cache, dfsGraph, ends[2 * p], ends[2 * p + 1], moved, num_obstacles, &query_steps, &rng);
+        } else {
+            r = cached_dijkstra(cache, g, v, ends[2 * p], ends[2 * p + 1], obstacles, num_obstacles, &rng);
+            query_steps = r.length - 1;
+        }
+        if (q == 0){
+            first = r;
+            *steps = query_steps;
+            IS_QUIET = 1; // Only the query of config.in prints its trace
+        } else {
+            free(r.path);
+        }
+    }
+    IS_QUIET = quiet;
+
+    out_cache_stats(&out, OUTPUT_FORMAT, cache);
+    free(moved);
+    free(ends);
+    free(blocked);
+    path_cache_free(cache);
+    return first;
+}
+
+//Renumbers the vertices for locality (REORDER_MODE) and maps the obstacles, start and goal to the new IDs.
+//Everything printed afterwards is translated back to the IDs of config.in.
+void applyReordering(graph ***g, int v, int *obstacles, int *start, int *goal){
+    locality_stats before, after;
+    measure_locality(*g, v, &before);
+
+    order = compute_vertex_order(*g, v, REORDER_MODE);
+    graph **renumbered = renumber_graph(*g, v, order);
+    deleteGraph(*g, v);
+    *g = renumbered;
+    measure_locality(*g, v, &after);
+
+    int *moved = malloc(sizeof(int) * (v + 1));
+    for (int i = 0; i < v; i++) moved[order->new_id[i]] = obstacles[i];
+    for (int i = 0; i < v; i++) obstacles[i] = moved[i];
+    free(moved);
+    *start = order->new_id[*start];
+    *goal = order->new_id[*goal];
+    setDFSTraceIds(order->old_id); //The DFS traces print vertices too
+
+    if (OUTPUT_FORMAT == OUTPUT_NDJSON){
+        out_str(&out, "{\"type\":\"reorder\",\"mode\":\"");
+        out_str(&out, REORDER_MODE == REORDER_RCM ? "rcm" : "bfs");
+        out_str(&out, "\",\"bandwidth\":[");
+        out_int(&out, before.bandwidth);
+        out_char(&out, ',');
+        out_int(&out, after.bandwidth);
+        out_str(&out, "],\"mean_gap\":[");
+        out_double(&out, before.mean_gap);
+        out_char(&out, ',');
+        out_double(&out, after.mean_gap);
+        out_str(&out, "],\"cache_misses\":[");
+        out_long(&out, before.cache_misses);
+        out_char(&out, ',');
+        out_long(&out, after.cache_misses);
+        out_str(&out, "]}\n");
+    } else if (OUTPUT_FORMAT == OUTPUT_TEXT){
+        out_str(&out, REORDER_MODE == REORDER_RCM ? "Reordering (RCM)" : "Reordering (BFS)");
+        out_str(&out, "\n  Bandwidth: ");
+        out_int(&out, before.bandwidth);
+        out_str(&out, " -> ");
+        out_int(&out, after.bandwidth);
+        out_str(&out, "\n  Mean edge gap: ");
+        out_double(&out, before.mean_gap);
+        out_str(&out, " -> ");
+        out_double(&out, after.mean_gap);
+        out_str(&out, "\n  Simulated cache misses (32 KB): ");
+        out_long(&out, before.cache_misses);
+        out_str(&out, " -> ");
+        out_long(&out, after.cache_misses);
+        out_char(&out, '\n');
+    }
+}
+
+//Maps a vertex of config.in to its internal ID
+int internalId(int x){
+    return order ? order->new_id[x] : x;
+}
+
+//Maps an internal vertex ID back to the ID used in config.in
+int originalId(int x){
+    return order ? order->old_id[x] : x;
+}
+
+//Rewrites a planner path in the IDs of config.in
+void translatePath(path_result *result){
+    for (int i = 0; i < result->length && result->path; i++){
+        result->path[i] = originalId(result->path[i]);
+    }
+}
+
 //Displays the adjacency list
 void viewList(graph **g, int v){
-    int i;
+    int i, count, max_degree = 0;
     graph *p;
-    
+
     for(i = 0; i < v; i++){
-        p = g[i];
-        printf("%d: ", i);
-        while(p != NULL){
-            printf("%3d", p->x);
-            p = p->next;
+        count = 0;
+        for(p = g[i]; p != NULL; p = p->next) count++;
+        if(count > max_degree) max_degree = count;
+    }
+
+    int *neighbors = malloc(sizeof(int) * (max_degree + 1));
+    for(i = 0; i < v; i++){
+        count = 0;
+        for(p = g[i]; p != NULL; p = p->next){
+            neighbors[count++] = p->x;
         }
-        printf("\n");
+        out_adjacency(&out, OUTPUT_FORMAT, i, neighbors, count);
     }
+    free(neighbors);
 }
 
 //Frees the memory allocated for the graph
@@ -209,11 +653,14 @@ int *readObstaclesDFS(int v, int *num_obstacles, int *start, int *goal) {
     int *obstacles = malloc((*num_obstacles) * sizeof(int)); // Allocate space for the obstacle list
     for (int i = 0; i < *num_obstacles; i++) {
         fscanf(fp, "%d", &obstacles[i]); // Directly store the vertex index
+        obstacles[i] = internalId(obstacles[i]);
     }
 
     // Read start and goal
     fscanf(fp, "%d", start);
     fscanf(fp, "%d", goal);
+    *start = internalId(*start);
+    *goal = internalId(*goal);
 
     fclose(fp);
     return obstacles;
@@ -222,22 +669,18 @@ int *readObstaclesDFS(int v, int *num_obstacles, int *start, int *goal) {
 
 // Print the list of obstacle vertices
 void printObstacles(int *obstacles, int v) {
-    printf("Obstacles at: ");
+    int *vertices = malloc(sizeof(int) * (v + 1));
     int found = 0;
     for (int i = 0; i < v; i++) {
         if (obstacles[i]) {
-            printf("%d ", i);
-            found = 1;
+            vertices[found++] = i;
         }
     }
-    if (!found) {
-        printf("None");
-    }
-    printf("\n");
+    out_obstacles(&out, OUTPUT_FORMAT, vertices, found);
+    free(vertices);
 }
 
 // Print the start and goal vertices
 void printStartGoal(int start, int goal) {
-    printf("Start vertex: %d\n", start);
-    printf("Goal vertex: %d\n", goal);
+    out_query(&out, OUTPUT_FORMAT, start, goal);
 }
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include "montecarlo.h"
+#include "dfs_pathfinder.h"
+#include "planner.h"
+
+/* ---------------------------------- Structures ---------------------------------- */
+
+// State of one worker thread; histograms are private and merged after the join
+typedef struct {
+    const sim_scenario *scenario; /**< Problem being simulated. */
+    atomic_int *next_trial;       /**< Shared index of the next trial to run. */
+    int trials;                   /**< Total number of trials. */
+    uint64_t seed;                /**< Seed of the trial streams. */
+    sim_report local;             /**< Partial results of this worker. */
+    long long step_sum;           /**< Sum of steps of successful trials. */
+} sim_worker;
+
+/* ---------------------------------- Simulation ---------------------------------- */
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Runs trial number `trial` and returns its step count, or -1 if the goal was not reached
+static int run_trial(const sim_scenario *s, planner_context *planner, uint64_t seed, int trial, int *dfs_obstacles) {
+    rng_stream rng;
+    rng_init(&rng, seed, (uint64_t)trial);
+
+    if (s->planner == PLANNER_DFS) {
+        // The DFS moves obstacles in place, so each thread works on its own copy
+        memcpy(dfs_obstacles, s->obstacles, s->num_obstacles * sizeof(int));
+        int steps;
+        path_result r = planner_dfs(planner, s->start, s->goal, dfs_obstacles, s->num_obstacles, &steps, &rng);
+        return r.path ? steps : -1;
+    }
+
+    path_result r = planner_dijkstra(planner, s->start, s->goal, s->obstacles, &rng);
+    return r.path ? r.length - 1 : -1;
+}
+
+static void *sim_worker_main(void *arg) {
+    sim_worker *w = arg;
+    int *dfs_obstacles = malloc((w->scenario->num_obstacles + 1) * sizeof(int));
+    const sim_scenario *s = w->scenario;
+
+    // Scratch memory is allocated once per thread and reused by every trial
+    planner_context *planner = s->planner == PLANNER_DFS ? planner_create(NULL, s->v, s->dfs_graph)
+                                                         : planner_create(s->g, s->v, NULL);
+
+    // Trials are handed out one at a time; trial i always uses stream i, so the
+    // results do not depend on how trials end up distributed over the threads
+    int trial;
+    while ((trial = atomic_fetch_add(w->next_trial, 1)) < w->trials) {
+        double t0 = now_seconds();
+        int steps = run_trial(s, planner, w->seed, trial, dfs_obstacles);
+        double micros = (now_seconds() - t0) * 1e6;
+
+        int bin = 0;
+        while (bin < SIM_LATENCY_BINS - 1 && micros >= (double)(2LL << bin)) bin++;
+        w->local.latency_hist[bin]++;
+
+        if (steps >= 0) {
+            w->local.successes++;
+            w->local.step_hist[steps < SIM_STEP_BINS ? steps : SIM_STEP_BINS - 1]++;
+            w->step_sum += steps;
+            if (steps < w->local.min_steps) w->local.min_steps = steps;
+            if (steps > w->local.max_steps) w->local.max_steps = steps;
+        }
+    }
+
+    planner_free(planner);
+    free(dfs_obstacles);
+    return NULL;
+}
+
+/**
+ * @brief Runs independent seeded trials of a scenario across worker threads.
+ * @param scenario Planning problem; it is only read, never modified.
+ * @param trials Number of trials to run.
+ * @param threads Number of worker threads, 0 for one per online CPU.
+ * @param seed Seed of the counter-based streams; trial i uses stream i.
+ * @param report Filled with the aggregated distribution of the trials.
+ * @note The planners must not print traces while running (IS_QUIET).
+ */
+void run_simulation(const sim_scenario *scenario, int trials, int threads, uint64_t seed, sim_report *report) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > trials && trials > 0) threads = trials;
+
+    atomic_int next_trial;
+    atomic_init(&next_trial, 0);
+
+    sim_worker *workers = calloc(threads, sizeof(sim_worker));
+    pthread_t *tids = malloc(threads * sizeof(pthread_t));
+
+    double t0 = now_seconds();
+    for (int i = 0; i < threads; i++) {
+        workers[i].scenario = scenario;
+        workers[i].next_trial = &next_trial;
+        workers[i].trials = trials;
+        workers[i].seed = seed;
+        workers[i].local.min_steps = 1000000;
+        workers[i].local.max_steps = -1;
+        pthread_create(&tids[i], NULL, sim_worker_main, &workers[i]);
+    }
+
+    memset(report, 0, sizeof(*report));
+    report->trials = trials;
+    report->threads = threads;
+    report->seed = seed;
+    report->min_steps = 1000000;
+    report->max_steps = -1;
+
+    long long step_sum = 0;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tids[i], NULL);
+        sim_report *l = &workers[i].local;
+        report->successes += l->successes;
+        step_sum += workers[i].step_sum;
+        if (l->min_steps < report->min_steps) report->min_steps = l->min_steps;
+        if (l->max_steps > report->max_steps) report->max_steps = l->max_steps;
+        for (int b = 0; b < SIM_STEP_BINS; b++) report->step_hist[b] += l->step_hist[b];
+        for (int b = 0; b < SIM_LATENCY_BINS; b++) report->latency_hist[b] += l->latency_hist[b];
+    }
+    report->wall_seconds = now_seconds() - t0;
+
+    if (report->successes == 0) report->min_steps = -1;
+    report->mean_steps = report->successes ? (double)step_sum / report->successes : 0.0;
+    report->trials_per_second = report->wall_seconds > 0 ? trials / report->wall_seconds : 0.0;
+
+    free(workers);
+    free(tids);
+}
+
+/* ---------------------------------- Report ---------------------------------- */
+
+// Smallest bin holding at least `fraction` of the histogram mass, -1 if empty
+static int hist_quantile(const long long *hist, int bins, double fraction) {
+    long long total = 0;
+    for (int b = 0; b < bins; b++) total += hist[b];
+    if (total == 0) return -1;
+
+    long long seen = 0;
+    for (int b = 0; b < bins; b++) {
+        seen += hist[b];
+        if (seen >= fraction * total) return b;
+    }
+    return bins - 1;
+}
+
+// Writes the simulation summary and both histograms in the selected output format
+void out_sim_report(out_writer *w, int format, const sim_report *r) {
+    if (format == OUTPUT_NDJSON) {
+        out_str(w, "{\"type\":\"simulation\",\"trials\":");
+        out_int(w, r->trials);
+        out_str(w, ",\"threads\":");
+        out_int(w, r->threads);
+        out_str(w, ",\"seed\":");
+        out_u64(w, r->seed);
+        out_str(w, ",\"successes\":");
+        out_int(w, r->successes);
+        out_str(w, ",\"min_steps\":");
+        out_int(w, r->min_steps);
+        out_str(w, ",\"max_steps\":");
+        out_int(w, r->max_steps);
+        out_str(w, ",\"mean_steps\":");
+        out_double(w, r->mean_steps);
+        out_str(w, ",\"seconds\":");
+        out_double(w, r->wall_seconds);
+        out_str(w, ",\"trials_per_second\":");
+        out_double(w, r->trials_per_second);
+        out_str(w, ",\"step_hist\":[");
+        for (int b = 0; b < SIM_STEP_BINS; b++) {
+            if (b > 0) out_char(w, ',');
+            out_long(w, r->step_hist[b]);
+        }
+        out_str(w, "],\"latency_hist_us_log2\":[");
+        for (int b = 0; b < SIM_LATENCY_BINS; b++) {
+            if (b > 0) out_char(w, ',');
+            out_long(w, r->latency_hist[b]);
+        }
+        out_str(w, "]}\n");
+    } else if (format == OUTPUT_BINARY) {
+        out_i32(w, REC_SIMULATION);
+        out_i32(w, r->trials);
+        out_i32(w, r->threads);
+        out_i64(w, (long long)r->seed);
+        out_i32(w, r->successes);
+        out_i32(w, r->min_steps);
+        out_i32(w, r->max_steps);
+        out_i64(w, (long long)(r->wall_seconds * 1e6));
+        out_i32(w, SIM_STEP_BINS);
+        for (int b = 0; b < SIM_STEP_BINS; b++) out_i64(w, r->step_hist[b]);
+        out_i32(w, SIM_LATENCY_BINS);
+        for (int b = 0; b < SIM_LATENCY_BINS; b++) out_i64(w, r->latency_hist[b]);
+    } else {
+        out_str(w, "\n--- Monte Carlo Simulation ---\nTrials: ");
+        out_int(w, r->trials);
+        out_str(w, " on ");
+        out_int(w, r->threads);
+        out_str(w, " threads, seed ");
+        out_u64(w, r->seed);
+        out_str(w, "\nSuccess rate: ");
+        out_double(w, r->trials ? 100.0 * r->successes / r->trials : 0.0);
+        out_str(w, "%\nSteps (min / mean / max): ");
+        out_int(w, r->min_steps);
+        out_str(w, " / ");
+        out_double(w, r->mean_steps);
+        out_str(w, " / ");
+        out_int(w, r->max_steps);
+        out_str(w, "\nSteps (p50 / p90 / p99): ");
+        out_int(w, hist_quantile(r->step_hist, SIM_STEP_BINS, 0.50));
+        out_str(w, " / ");
+        out_int(w, hist_quantile(r->step_hist, SIM_STEP_BINS, 0.90));
+        out_str(w, " / ");
+        out_int(w, hist_quantile(r->step_hist, SIM_STEP_BINS, 0.99));
+        out_str(w, "\n\nSteps histogram:\n");
+        for (int b = 0; b < SIM_STEP_BINS; b++) {
+            if (r->step_hist[b] == 0) continue;
+            out_int_padded(w, b, 4);
+            out_str(w, b == SIM_STEP_BINS - 1 ? "+: " : ":  ");
+            out_long(w, r->step_hist[b]);
+            out_char(w, '\n');
+        }
+        out_str(w, "\nLatency histogram (microseconds):\n");
+        for (int b = 0; b < SIM_LATENCY_BINS; b++) {
+            if (r->latency_hist[b] == 0) continue;
+            out_str(w, "  >=");
+            out_int_padded(w, b == 0 ? 0 : 1 << b, 8);
+            out_str(w, ": ");
+            out_long(w, r->latency_hist[b]);
+            out_char(w, '\n');
+        }
+        out_str(w, "\nSimulation time: ");
+        out_double(w, r->wall_seconds);
+        out_str(w, " seconds\nThroughput: ");
+        out_double(w, r->trials_per_second);
+        out_str(w, " trials/second\n");
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include <stdint.h>
+#include "dijkstras.h"
+#include "output.h"
+
+#define SIM_STEP_BINS    64  // Step counts 0..62 get their own bin, the last bin collects the rest
+#define SIM_LATENCY_BINS 32  // Bin b holds trials that took [2^b, 2^(b+1)) microseconds
+
+struct Graph;
+
+// One planning problem, shared read-only by every trial
+typedef struct {
+    int planner;              /**< PLANNER_DIJKSTRA or PLANNER_DFS. */
+    graph **g;                /**< Adjacency list used by Dijkstra. */
+    struct Graph *dfs_graph;  /**< Graph used by DFS. */
+    int v;                    /**< Number of vertices. */
+    int start;                /**< Start vertex of the robot. */
+    int goal;                 /**< Goal vertex. */
+    int *obstacles;           /**< Dijkstra: array of size v (1 = obstacle), DFS: list of obstacle vertices. */
+    int num_obstacles;        /**< Number of obstacles. */
+} sim_scenario;
+
+// Aggregated outcome of a simulation
+typedef struct {
+    int trials;                               /**< Number of trials run. */
+    int threads;                              /**< Number of worker threads used. */
+    uint64_t seed;                            /**< Seed of the trial streams. */
+    int successes;                            /**< Trials that reached the goal. */
+    int min_steps;                            /**< Fewest steps of a successful trial. */
+    int max_steps;                            /**< Most steps of a successful trial. */
+    double mean_steps;                        /**< Mean steps over successful trials. */
+    double wall_seconds;                      /**< Wall time of the whole simulation. */
+    double trials_per_second;                 /**< Throughput. */
+    long long step_hist[SIM_STEP_BINS];       /**< Distribution of steps of successful trials. */
+    long long latency_hist[SIM_LATENCY_BINS]; /**< Distribution of per-trial latency. */
+} sim_report;
+
+void run_simulation(const sim_scenario *scenario, int trials, int threads, uint64_t seed, sim_report *report);
+void out_sim_report(out_writer *w, int format, const sim_report *report);
+
+#endif
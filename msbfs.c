@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "msbfs.h"
+
+// Structure for graph nodes
+typedef struct node {
+    int x;              /**< Vertex number of the neighbor. */
+    struct node *next;  /**< Pointer to the next neighbor in the list. */
+} graph;
+
+/* ---------------------------------- Helpers ---------------------------------- */
+
+// Flattens the adjacency list into offsets/targets arrays so the kernel walks contiguous memory
+static void build_csr(graph **g, int v, int **offsets, int **targets) {
+    int *off = malloc((v + 1) * sizeof(int));
+    off[0] = 0;
+    for (int i = 0; i < v; i++) {
+        int degree = 0;
+        for (graph *p = g[i]; p != NULL; p = p->next) degree++;
+        off[i + 1] = off[i] + degree;
+    }
+
+    int *tgt = malloc((off[v] + 1) * sizeof(int));
+    for (int i = 0; i < v; i++) {
+        int k = off[i];
+        for (graph *p = g[i]; p != NULL; p = p->next) tgt[k++] = p->x;
+    }
+
+    *offsets = off;
+    *targets = tgt;
+}
+
+/* ---------------------------------- Multi-Source BFS ---------------------------------- */
+
+// Masks of one vertex, kept together so a push touches a single cache line
+typedef struct {
+    uint64_t seen[MSBFS_WORDS];     /**< Sources that already reached the vertex. */
+    uint64_t frontier[MSBFS_WORDS]; /**< Sources that reached it at the current level. */
+    uint64_t next[MSBFS_WORDS];     /**< Sources reaching it at the next level. */
+} msbfs_cell;
+
+// Scratch memory of the kernel, reused by every batch of a table build
+typedef struct {
+    msbfs_cell *cells;  /**< Masks of every vertex. */
+    int *active;        /**< Vertices with a non-empty frontier. */
+    int *touched;       /**< Vertices with a non-empty next mask. */
+} msbfs_scratch;
+
+/**
+ * @brief Runs one BFS per source for up to MSBFS_BATCH sources at once.
+ * @param off, tgt Graph in CSR form.
+ * @param sources Source vertices of this batch; bit b of a mask stands for sources[b].
+ * @param dist Output block of this batch, dist[x * MSBFS_BATCH + b], already filled with -1.
+ * @note Every vertex keeps a "seen" and a "frontier" mask. One level expands the
+ *       frontier of all sources with word-wide ORs, so a vertex shared by many
+ *       BFS trees is scanned once per level instead of once per source. Only the
+ *       vertices on the frontier are visited, so a level costs O(frontier edges).
+ */
+static void msbfs_batch(const int *off, const int *tgt, int v, const int *sources, int count, int *dist,
+                        msbfs_scratch *sc) {
+    msbfs_cell *cell = sc->cells;
+    int num_active = 0;
+
+    memset(cell, 0, v * sizeof(msbfs_cell));
+    for (int b = 0; b < count; b++) {
+        msbfs_cell *c = &cell[sources[b]];
+        int fresh = 1;
+        for (int w = 0; w < MSBFS_WORDS; w++) {
+            if (c->frontier[w]) fresh = 0;
+        }
+        if (fresh) sc->active[num_active++] = sources[b];
+        c->seen[b / 64] |= 1ULL << (b % 64);
+        c->frontier[b / 64] |= 1ULL << (b % 64);
+        dist[(long)sources[b] * MSBFS_BATCH + b] = 0;
+    }
+
+    for (int level = 1; num_active > 0; level++) {
+        int num_touched = 0;
+
+        // Push every frontier to the neighbors
+        for (int i = 0; i < num_active; i++) {
+            int x = sc->active[i];
+            uint64_t frontier[MSBFS_WORDS];
+            for (int w = 0; w < MSBFS_WORDS; w++) {
+                frontier[w] = cell[x].frontier[w];
+                cell[x].frontier[w] = 0;
+            }
+
+            for (int k = off[x]; k < off[x + 1]; k++) {
+                msbfs_cell *c = &cell[tgt[k]];
+                uint64_t was = 0, now = 0;
+                for (int w = 0; w < MSBFS_WORDS; w++) {
+                    was |= c->next[w];
+                    c->next[w] |= frontier[w] & ~c->seen[w];
+                    now |= c->next[w];
+                }
+                if (!was && now) sc->touched[num_touched++] = tgt[k];
+            }
+        }
+
+        // The new frontier holds the sources that reach a vertex for the first time
+        num_active = 0;
+        for (int i = 0; i < num_touched; i++) {
+            int y = sc->touched[i];
+            msbfs_cell *c = &cell[y];
+            for (int w = 0; w < MSBFS_WORDS; w++) {
+                uint64_t bits = c->next[w];
+                c->seen[w] |= bits;
+                c->frontier[w] = bits;
+                c->next[w] = 0;
+                while (bits) {
+                    int b = w * 64 + __builtin_ctzll(bits);
+                    dist[(long)y * MSBFS_BATCH + b] = level;
+                    bits &= bits - 1;
+                }
+            }
+            sc->active[num_active++] = y;
+        }
+    }
+}
+
+/**
+ * @brief Builds the hop distance table from the given sources to all vertices.
+ * @param g Adjacency list representation of the graph.
+ * @param v Number of vertices in the graph.
+ * @param sources Source vertices (e.g. landmarks or goals), one table row each.
+ * @param num_sources Number of sources.
+ * @return Table owned by the caller, release it with free_distance_table().
+ * @note Obstacles are ignored; the distances are lower bounds usable as heuristics.
+ */
+distance_table *build_distance_table(graph **g, int v, const int *sources, int num_sources) {
+    distance_table *t = malloc(sizeof(distance_table));
+    t->v = v;
+    t->num_sources = num_sources;
+    t->sources = malloc((num_sources + 1) * sizeof(int));
+    memcpy(t->sources, sources, num_sources * sizeof(int));
+    t->row_of = NULL;
+    long cells = (long)(num_sources + MSBFS_BATCH - 1) / MSBFS_BATCH * MSBFS_BATCH * v;
+    t->dist = malloc((cells + 1) * sizeof(int));
+    memset(t->dist, 0xff, cells * sizeof(int)); // All -1
+
+    int *off, *tgt;
+    build_csr(g, v, &off, &tgt);
+
+    msbfs_scratch sc;
+    sc.cells = malloc((v + 1) * sizeof(msbfs_cell));
+    sc.active = malloc((v + 1) * sizeof(int));
+    sc.touched = malloc((v + 1) * sizeof(int));
+
+    for (int first = 0; first < num_sources; first += MSBFS_BATCH) {
+        int count = num_sources - first < MSBFS_BATCH ? num_sources - first : MSBFS_BATCH;
+        msbfs_batch(off, tgt, v, sources + first, count, t->dist + (long)first * v, &sc);
+    }
+
+    free(sc.cells);
+    free(sc.active);
+    free(sc.touched);
+    free(off);
+    free(tgt);
+    return t;
+}
+
+/**
+ * @brief Distance table from every vertex to every vertex.
+ * @note Row i belongs to sources[i], which is not vertex i: the sources are grouped into
+ *       compact balls of MSBFS_BATCH vertices so the frontiers of a batch stay in step.
+ *       Use all_pairs_distance() to look up by vertex.
+ */
+distance_table *build_all_pairs_table(graph **g, int v) {
+    int *sources = malloc((v + 1) * sizeof(int));
+    int *order = malloc((v + 1) * sizeof(int));
+    int *queue = malloc((v + 1) * sizeof(int));
+    int *stamp = calloc(v + 1, sizeof(int));
+    int count = 0, batch = 0;
+
+    for (int i = 0; i < v; i++) order[i] = -1;
+    for (int root = 0; root < v; root++) {
+        if (order[root] >= 0) continue;
+
+        // Grow a ball around root and take the unassigned vertices nearest to it
+        int head = 0, tail = 0, taken = 0;
+        batch++;
+        stamp[root] = batch;
+        queue[tail++] = root;
+        while (head < tail && taken < MSBFS_BATCH) {
+            int x = queue[head++];
+            if (order[x] < 0) {
+                order[x] = count;
+                sources[count++] = x;
+                taken++;
+            }
+            for (graph *p = g[x]; p != NULL; p = p->next) {
+                if (stamp[p->x] != batch) {
+                    stamp[p->x] = batch;
+                    queue[tail++] = p->x;
+                }
+            }
+        }
+    }
+
+    distance_table *t = build_distance_table(g, v, sources, v);
+    t->row_of = order;
+    free(sources);
+    free(queue);
+    free(stamp);
+    return t;
+}
+
+void free_distance_table(distance_table *t) {
+    free(t->row_of);
+    free(t->sources);
+    free(t->dist);
+    free(t);
+}
+
+// Plain single-source BFS over the adjacency list, the reference for the batched kernel
+void bfs_single(graph **g, int v, int source, int *dist) {
+    int *queue = malloc((v + 1) * sizeof(int));
+    int head = 0, tail = 0;
+
+    for (int i = 0; i < v; i++) dist[i] = -1;
+    dist[source] = 0;
+    queue[tail++] = source;
+
+    while (head < tail) {
+        int x = queue[head++];
+        for (graph *p = g[x]; p != NULL; p = p->next) {
+            if (dist[p->x] < 0) {
+                dist[p->x] = dist[x] + 1;
+                queue[tail++] = p->x;
+            }
+        }
+    }
+
+    free(queue);
+}
@@ -0,0 +1,40 @@
+#ifndef MSBFS_H
+#define MSBFS_H
+
+#include "dijkstras.h"
+
+// Number of 64-bit words per vertex mask: 256 sources per batch with AVX2, 64 otherwise
+#ifdef __AVX2__
+#define MSBFS_WORDS 4
+#else
+#define MSBFS_WORDS 1
+#endif
+#define MSBFS_BATCH (64 * MSBFS_WORDS)
+
+// Hop distances from a set of sources to every vertex
+typedef struct {
+    int v;            /**< Number of vertices. */
+    int num_sources;  /**< Number of sources (rows). */
+    int *sources;     /**< Source vertex of each row. */
+    int *dist;        /**< Hops from sources[i] to x (-1 if unreachable), see table_distance(). */
+    int *row_of;      /**< All-pairs tables only: row of the table whose source is vertex s. */
+} distance_table;
+
+distance_table *build_distance_table(graph **g, int v, const int *sources, int num_sources);
+distance_table *build_all_pairs_table(graph **g, int v);
+void free_distance_table(distance_table *t);
+void bfs_single(graph **g, int v, int source, int *dist);
+
+// Hops from row `source_index` of the table to vertex x. Rows are stored in blocks of
+// MSBFS_BATCH sources laid out vertex-major, which is the order the kernel produces them in.
+static inline int table_distance(const distance_table *t, int source_index, int x) {
+    long block = source_index / MSBFS_BATCH;
+    return t->dist[(block * t->v + x) * MSBFS_BATCH + source_index % MSBFS_BATCH];
+}
+
+// Hops from vertex s to vertex x in an all-pairs table
+static inline int all_pairs_distance(const distance_table *t, int s, int x) {
+    return table_distance(t, t->row_of[s], x);
+}
+
+#endif
@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <string.h>
+#include "output.h"
+
+/* ---------------------------------- Buffered Writer ---------------------------------- */
+
+// Bind a writer to an output stream
+void out_init(out_writer *w, FILE *fp) {
+    w->fp = fp;
+    w->len = 0;
+}
+
+// Write all pending bytes to the stream
+void out_flush(out_writer *w) {
+    if (w->len > 0) {
+        fwrite(w->buf, 1, w->len, w->fp);
+        w->len = 0;
+    }
+    fflush(w->fp);
+}
+
+// Make sure at least n more bytes fit in the buffer
+static void out_reserve(out_writer *w, int n) {
+    if (w->len + n > OUT_BUF_SIZE) {
+        fwrite(w->buf, 1, w->len, w->fp);
+        w->len = 0;
+    }
+}
+
+void out_char(out_writer *w, char c) {
+    out_reserve(w, 1);
+    w->buf[w->len++] = c;
+}
+
+void out_str(out_writer *w, const char *s) {
+    while (*s) {
+        out_char(w, *s++);
+    }
+}
+
+// Format an integer without going through printf: digits are produced right to left
+void out_int(out_writer *w, int x) {
+    char tmp[12];
+    int n = 0;
+    unsigned int u = x < 0 ? 0u - (unsigned int)x : (unsigned int)x;
+
+    do {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u > 0);
+    if (x < 0) tmp[n++] = '-';
+
+    out_reserve(w, n);
+    while (n > 0) {
+        w->buf[w->len++] = tmp[--n];
+    }
+}
+
+// Same as printf("%llu"), for seeds
+void out_u64(out_writer *w, unsigned long long x) {
+    char tmp[20];
+    int n = 0;
+    do {
+        tmp[n++] = (char)('0' + x % 10);
+        x /= 10;
+    } while (x > 0);
+
+    out_reserve(w, n);
+    while (n > 0) {
+        w->buf[w->len++] = tmp[--n];
+    }
+}
+
+// Same as printf("%lld"), for counters that may not fit in an int
+void out_long(out_writer *w, long long x) {
+    if (x < 0) {
+        out_char(w, '-');
+        out_u64(w, 0ULL - (unsigned long long)x);
+    } else {
+        out_u64(w, (unsigned long long)x);
+    }
+}
+
+// Same as printf("%<width>d")
+void out_int_padded(out_writer *w, int x, int width) {
+    int digits = x <= 0 ? 1 : 0;
+    for (int t = x; t != 0; t /= 10) digits++;
+    for (int i = digits; i < width; i++) {
+        out_char(w, ' ');
+    }
+    out_int(w, x);
+}
+
+// Doubles are rare (timings only), so they still go through snprintf
+void out_double(out_writer *w, double x) {
+    char tmp[64];
+    snprintf(tmp, sizeof(tmp), "%f", x);
+    out_str(w, tmp);
+}
+
+// Raw 32-bit little-endian integer for the binary record stream
+void out_i32(out_writer *w, int x) {
+    unsigned int u = (unsigned int)x;
+    out_reserve(w, 4);
+    w->buf[w->len++] = (char)(u & 0xff);
+    w->buf[w->len++] = (char)((u >> 8) & 0xff);
+    w->buf[w->len++] = (char)((u >> 16) & 0xff);
+    w->buf[w->len++] = (char)((u >> 24) & 0xff);
+}
+
+// Raw 64-bit little-endian integer, for counters that may not fit in 32 bits
+void out_i64(out_writer *w, long long x) {
+    unsigned long long u = (unsigned long long)x;
+    out_reserve(w, 8);
+    for (int i = 0; i < 8; i++) w->buf[w->len++] = (char)((u >> (8 * i)) & 0xff);
+}
+
+/* ---------------------------------- Records ---------------------------------- */
+
+static const char *planner_names[] = {"dijkstra", "dfs", "jps", "hierarchical"};
+
+// JSON array of integers
+static void out_json_ints(out_writer *w, const int *values, int count) {
+    out_char(w, '[');
+    for (int i = 0; i < count; i++) {
+        if (i > 0) out_char(w, ',');
+        out_int(w, values[i]);
+    }
+    out_char(w, ']');
+}
+
+// Magic "MGMP" followed by the format version, written once at the start of a binary stream
+void out_binary_header(out_writer *w) {
+    out_str(w, "MGMP");
+    out_i32(w, 3); // Version 3: REC_SIMULATION time and histogram counts are int64
+}
+
+// One line of the adjacency list
+void out_adjacency(out_writer *w, int format, int vertex, const int *neighbors, int count) {
+    if (format == OUTPUT_NDJSON) {
+        out_str(w, "{\"type\":\"adjacency\",\"vertex\":");
+        out_int(w, vertex);
+        out_str(w, ",\"neighbors\":");
+        out_json_ints(w, neighbors, count);
+        out_str(w, "}\n");
+    } else if (format == OUTPUT_BINARY) {
+        out_i32(w, REC_ADJACENCY);
+        out_i32(w, vertex);
+        out_i32(w, count);
+        for (int i = 0; i < count; i++) out_i32(w, neighbors[i]);
+    } else {
+        out_int(w, vertex);
+        out_str(w, ": ");
+        for (int i = 0; i < count; i++) out_int_padded(w, neighbors[i], 3);
+        out_char(w, '\n');
+    }
+}
+
+// List of obstacle vertices
+void out_obstacles(out_writer *w, int format, const int *vertices, int count) {
+    if (format == OUTPUT_NDJSON) {
+        out_str(w, "{\"type\":\"obstacles\",\"vertices\":");
+        out_json_ints(w, vertices, count);
+        out_str(w, "}\n");
+    } else if (format == OUTPUT_BINARY) {
+        out_i32(w, REC_OBSTACLES);
+        out_i32(w, count);
+        for (int i = 0; i < count; i++) out_i32(w, vertices[i]);
+    } else {
+        out_str(w, "Obstacles at: ");
+        for (int i = 0; i < count; i++) {
+            out_int(w, vertices[i]);
+            out_char(w, ' ');
+        }
+        if (count == 0) out_str(w, "None");
+        out_char(w, '\n');
+    }
+}
+
+// Start and goal vertices
+void out_query(out_writer *w, int format, int start, int goal) {
+    if (format == OUTPUT_NDJSON) {
+        out_str(w, "{\"type\":\"query\",\"start\":");
+        out_int(w, start);
+        out_str(w, ",\"goal\":");
+        out_int(w, goal);
+        out_str(w, "}\n");
+    } else if (format == OUTPUT_BINARY) {
+        out_i32(w, REC_QUERY);
+        out_i32(w, start);
+        out_i32(w, goal);
+    } else {
+        out_str(w, "Start vertex: ");
+        out_int(w, start);
+        out_str(w, "\nGoal vertex: ");
+        out_int(w, goal);
+        out_char(w, '\n');
+    }
+}
+
+/**
+ * @brief Writes the outcome of one planner run.
+ * @param path Vertices of the path, or NULL if no path was found.
+ * @param length Number of vertices in path.
+ * @param steps Total number of steps (robot and obstacle moves) taken.
+ * @param seconds Wall time spent planning.
+ */
+void out_result(out_writer *w, int format, int planner, const int *path, int length,
+                int steps, double seconds) {
+    int found = path != NULL;
+    if (!found) length = 0;
+
+    if (format == OUTPUT_NDJSON) {
+        out_str(w, "{\"type\":\"result\",\"planner\":\"");
+        out_str(w, planner_names[planner]);
+        out_str(w, found ? "\",\"found\":true" : "\",\"found\":false");
+        out_str(w, ",\"steps\":");
+        out_int(w, found ? steps : -1);
+        out_str(w, ",\"path\":");
+        out_json_ints(w, path, length);
+        out_str(w, ",\"seconds\":");
+        out_double(w, seconds);
+        out_str(w, "}\n");
+    } else if (format == OUTPUT_BINARY) {
+        out_i32(w, REC_RESULT);
+        out_i32(w, planner);
+        out_i32(w, found);
+        out_i32(w, found ? steps : -1);
+        out_i32(w, (int)(seconds * 1e6));
+        out_i32(w, length);
+        for (int i = 0; i < length; i++) out_i32(w, path[i]);
+    } else {
+        if (!found) {
+            out_str(w, "No path found\n");
+        } else if (planner == PLANNER_DFS) {
+            out_str(w, "\nShortest path from ");
+            out_int(w, path[0]);
+            out_str(w, " to ");
+            out_int(w, path[length - 1]);
+            out_str(w, " using DFS: ");
+            for (int i = 0; i < length; i++) {
+                out_int(w, path[i]);
+                out_char(w, ' ');
+            }
+            out_str(w, "\nPath length (robot moves): ");
+            out_int(w, length - 1);
+            out_str(w, "\nTotal steps (robot + obstacles): ");
+            out_int(w, steps);
+            out_char(w, '\n');
+        } else {
+            out_str(w, "Path found: ");
+            for (int i = 0; i < length; i++) {
+                out_int(w, path[i]);
+                out_char(w, ' ');
+            }
+            out_str(w, "\nNumber of steps: ");
+            out_int(w, steps);
+            out_char(w, '\n');
+        }
+        out_str(w, "Time taken: ");
+        out_double(w, seconds);
+        out_str(w, " seconds\n");
+    }
+}
+
+/**
+ * @brief Writes a record of named counters, the shape shared by the stats of the planners.
+ * @param tag REC_* tag of the binary record, followed by the fields that have a key, in order.
+ * @param type "type" of the NDJSON object.
+ * @param text_end Written after the last field in text mode.
+ */
+void out_stats(out_writer *w, int format, int tag, const char *type, const out_field *fields, int count,
+               const char *text_end) {
+    if (format == OUTPUT_NDJSON) {
+        out_str(w, "{\"type\":\"");
+        out_str(w, type);
+        out_char(w, '"');
+        for (int i = 0; i < count; i++) {
+            if (fields[i].key == NULL) continue;
+            out_str(w, ",\"");
+            out_str(w, fields[i].key);
+            out_str(w, "\":");
+            out_long(w, fields[i].value);
+        }
+        out_str(w, "}\n");
+    } else if (format == OUTPUT_BINARY) {
+        out_i32(w, tag);
+        for (int i = 0; i < count; i++) {
+            if (fields[i].key == NULL) continue;
+            if (fields[i].kind == OUT_FIELD_INT) {
+                out_i32(w, (int)fields[i].value);
+            } else {
+                out_i64(w, fields[i].value);
+            }
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            if (fields[i].text == NULL) continue;
+            out_str(w, fields[i].text);
+            if (fields[i].kind == OUT_FIELD_PERCENT) {
+                out_double(w, fields[i].total ? 100.0 * fields[i].value / fields[i].total : 0.0);
+            } else {
+                out_long(w, fields[i].value);
+            }
+        }
+        out_str(w, text_end);
+    }
+}
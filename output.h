@@ -0,0 +1,77 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+
+// Output formats selectable through OUTPUT_FORMAT in main.c
+#define OUTPUT_TEXT   0  // Human readable text (default)
+#define OUTPUT_NDJSON 1  // One JSON object per line
+#define OUTPUT_BINARY 2  // Tagged little-endian int32 record stream
+
+// Tags of the records written in OUTPUT_BINARY mode
+#define REC_ADJACENCY 1  // vertex, count, neighbors[count]
+#define REC_OBSTACLES 2  // count, vertices[count]
+#define REC_QUERY     3  // start, goal
+#define REC_RESULT    4  // planner, found, steps, micros, length, path[length]
+#define REC_SIMULATION 5 // trials, threads, seed (int64), successes, min, max, micros (int64),
+                         // bins, steps[bins] (int64), bins, latency[bins] (int64)
+#define REC_CACHE     6  // hits (int64), misses (int64), evictions (int64), entries, bytes (int64)
+#define REC_DFS_STATS 7  // nodes, tt_probes, tt_hits, tasks, steals (all int64)
+#define REC_HIER_STATS 8 // clusters, boundary, rebuilds (int64), replans, abstract_expansions (int64),
+                         // refined (int64)
+
+// Planner ids reported in result records
+#define PLANNER_DIJKSTRA 0
+#define PLANNER_DFS      1
+#define PLANNER_JPS      2
+#define PLANNER_HIERARCHICAL 3
+
+// Quiet mode: skip graph dumps and search traces (defined in main.c)
+extern int IS_QUIET;
+extern int OUTPUT_FORMAT;
+
+// Kinds of the fields of a stats record
+#define OUT_FIELD_INT     0  // int32 in binary records
+#define OUT_FIELD_LONG    1  // int64 in binary records
+#define OUT_FIELD_PERCENT 2  // 100 * value / total, text only
+
+// One field of a stats record written by out_stats()
+typedef struct {
+    const char *key;   /**< NDJSON key, NULL for a text-only field. */
+    const char *text;  /**< Written before the value in text mode, NULL to leave the field out of the text. */
+    int kind;          /**< OUT_FIELD_INT, OUT_FIELD_LONG or OUT_FIELD_PERCENT. */
+    long long value;   /**< Value of the field, numerator of a percentage. */
+    long long total;   /**< Denominator of a percentage (0 prints 0%). */
+} out_field;
+
+#define OUT_BUF_SIZE (1 << 16)
+
+// Buffered writer: bytes are collected in buf and written with one fwrite when full
+typedef struct {
+    FILE *fp;               /**< Destination stream. */
+    int len;                /**< Number of bytes currently buffered. */
+    char buf[OUT_BUF_SIZE]; /**< Pending output. */
+} out_writer;
+
+void out_init(out_writer *w, FILE *fp);
+void out_flush(out_writer *w);
+void out_char(out_writer *w, char c);
+void out_str(out_writer *w, const char *s);
+void out_int(out_writer *w, int x);
+void out_u64(out_writer *w, unsigned long long x);
+void out_long(out_writer *w, long long x);
+void out_int_padded(out_writer *w, int x, int width);
+void out_double(out_writer *w, double x);
+void out_i32(out_writer *w, int x);
+void out_i64(out_writer *w, long long x);
+
+void out_binary_header(out_writer *w);
+void out_adjacency(out_writer *w, int format, int vertex, const int *neighbors, int count);
+void out_obstacles(out_writer *w, int format, const int *vertices, int count);
+void out_query(out_writer *w, int format, int start, int goal);
+void out_result(out_writer *w, int format, int planner, const int *path, int length,
+                int steps, double seconds);
+void out_stats(out_writer *w, int format, int tag, const char *type, const out_field *fields, int count,
+               const char *text_end);
+
+#endif
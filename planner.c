@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "planner.h"
+#include "dfs_pathfinder.h"
+
+/**
+ * @brief Creates the reusable scratch memory of one graph.
+ * @param g Adjacency list for Dijkstra queries, or NULL.
+ * @param dfs_graph Graph for DFS queries, or NULL.
+ * @note Not thread-safe; use one context per planning thread.
+ */
+planner_context *planner_create(graph **g, int v, struct Graph *dfs_graph) {
+    planner_context *p = malloc(sizeof(planner_context));
+    p->g = g;
+    p->v = v;
+    p->search = g ? dijkstra_search_alloc(g, v) : NULL;
+    p->dfs = dfs_graph ? createDFSPlanner(dfs_graph) : NULL;
+    p->path_capacity = 2 * v + 16;
+    p->path = malloc(p->path_capacity * sizeof(int));
+    return p;
+}
+
+/**
+ * @brief dijkstra_rng() on the context's queue and state table.
+ * @return Path owned by the context, valid until its next query ({NULL, 0} if none).
+ * @note The same stream gives the same path as dijkstra_rng() and is advanced past the same
+ *       draws. The path buffer only grows when a path is longer than every earlier one.
+ */
+path_result planner_dijkstra(planner_context *p, int start, int goal, int *obstacles, rng_stream *rng) {
+    path_result result = {NULL, 0};
+
+    dijkstra_search_restart(p->search, start, goal, obstacles, rng);
+    int status = dijkstra_search_step(p->search, 0, 0);
+    *rng = dijkstra_search_rng(p->search);
+    if (status != SEARCH_FOUND) return result;
+
+    int length = dijkstra_search_trace(p->search, p->path, p->path_capacity);
+    if (length > p->path_capacity) {
+        p->path_capacity = 2 * length;
+        p->path = realloc(p->path, p->path_capacity * sizeof(int));
+        dijkstra_search_trace(p->search, p->path, p->path_capacity);
+    }
+    result.path = p->path;
+    result.length = length;
+    return result;
+}
+
+/**
+ * @brief planShortestPathDFS() on the context's DFS buffers.
+ * @param obstacles Obstacle vertices; moved during the search and restored before returning.
+ * @return Path owned by the context, valid until its next query ({NULL, 0} if none).
+ */
+path_result planner_dfs(planner_context *p, int start, int goal, int *obstacles, int num_obstacles, int *steps,
+                        rng_stream *rng) {
+    return planWithDFSPlanner(p->dfs, start, goal, obstacles, num_obstacles, steps, rng, NULL);
+}
+
+void planner_free(planner_context *p) {
+    if (p->search) dijkstra_search_free(p->search);
+    if (p->dfs) freeDFSPlanner(p->dfs);
+    free(p->path);
+    free(p);
+}
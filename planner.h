@@ -0,0 +1,26 @@
+#ifndef PLANNER_H
+#define PLANNER_H
+
+#include "dijkstras.h"
+
+struct Graph;
+struct DFSWorker;
+
+// Scratch memory for repeated queries on one graph. Created once, every buffer keeps its largest size,
+// so queries that fit in what earlier queries needed do no heap allocation.
+typedef struct {
+    graph **g;                 /**< Adjacency list used by Dijkstra. */
+    int v;                     /**< Number of vertices. */
+    dijkstra_search *search;   /**< Dijkstra queue and state table, NULL without an adjacency list. */
+    struct DFSWorker *dfs;     /**< DFS buffers and transposition table, NULL without a DFS graph. */
+    int *path;                 /**< Last Dijkstra path. */
+    int path_capacity;         /**< Allocated length of path. */
+} planner_context;
+
+planner_context *planner_create(graph **g, int v, struct Graph *dfs_graph);
+path_result planner_dijkstra(planner_context *p, int start, int goal, int *obstacles, rng_stream *rng);
+path_result planner_dfs(planner_context *p, int start, int goal, int *obstacles, int num_obstacles, int *steps,
+                        rng_stream *rng);
+void planner_free(planner_context *p);
+
+#endif
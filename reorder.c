@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "reorder.h"
+
+// Structure for graph nodes
+typedef struct node {
+    int x;              /**< Vertex number of the neighbor. */
+    struct node *next;  /**< Pointer to the next neighbor in the list. */
+} graph;
+
+#define CACHE_LINE_INTS 16   // 64-byte lines of int-sized per-vertex data
+#define CACHE_LINES     512  // 32 KB
+
+/* ---------------------------------- Orderings ---------------------------------- */
+
+static int degree_of(graph **g, int x) {
+    int d = 0;
+    for (graph *p = g[x]; p != NULL; p = p->next) d++;
+    return d;
+}
+
+/**
+ * @brief Computes a locality-improving numbering of the vertices.
+ * @param mode REORDER_BFS or REORDER_RCM.
+ * @return Mapping owned by the caller, release it with free_vertex_order().
+ * @note Each connected component is numbered from a vertex of minimum degree. For RCM the
+ *       neighbors of a vertex are queued by increasing degree and the final order is
+ *       reversed, which keeps the edges close to the diagonal (small bandwidth).
+ */
+vertex_order *compute_vertex_order(graph **g, int v, int mode) {
+    vertex_order *order = malloc(sizeof(vertex_order));
+    order->v = v;
+    order->new_id = malloc((v + 1) * sizeof(int));
+    order->old_id = malloc((v + 1) * sizeof(int));
+
+    int *degree = malloc((v + 1) * sizeof(int));
+    int *by_degree = malloc((v + 1) * sizeof(int));
+    for (int i = 0; i < v; i++) {
+        degree[i] = degree_of(g, i);
+        order->new_id[i] = -1;
+    }
+
+    // Vertices sorted by degree (counting sort), used to pick component roots
+    int max_degree = 0;
+    for (int i = 0; i < v; i++) {
+        if (degree[i] > max_degree) max_degree = degree[i];
+    }
+    int *bucket = calloc(max_degree + 2, sizeof(int));
+    for (int i = 0; i < v; i++) bucket[degree[i] + 1]++;
+    for (int d = 0; d <= max_degree; d++) bucket[d + 1] += bucket[d];
+    for (int i = 0; i < v; i++) by_degree[bucket[degree[i]]++] = i;
+    free(bucket);
+
+    int count = 0;
+    for (int r = 0; r < v; r++) {
+        int root = by_degree[r];
+        if (order->new_id[root] >= 0) continue;
+
+        int head = count;
+        order->new_id[root] = count;
+        order->old_id[count++] = root;
+        while (head < count) {
+            int x = order->old_id[head++];
+            int first = count;
+            for (graph *p = g[x]; p != NULL; p = p->next) {
+                if (order->new_id[p->x] < 0) {
+                    order->new_id[p->x] = count;
+                    order->old_id[count++] = p->x;
+                }
+            }
+
+            // Cuthill-McKee: children by increasing degree (insertion sort, lists are short)
+            if (mode == REORDER_RCM) {
+                for (int i = first + 1; i < count; i++) {
+                    int y = order->old_id[i];
+                    int j = i - 1;
+                    while (j >= first && degree[order->old_id[j]] > degree[y]) {
+                        order->old_id[j + 1] = order->old_id[j];
+                        j--;
+                    }
+                    order->old_id[j + 1] = y;
+                }
+            }
+        }
+    }
+
+    if (mode == REORDER_RCM) {
+        for (int i = 0, j = v - 1; i < j; i++, j--) {
+            int tmp = order->old_id[i];
+            order->old_id[i] = order->old_id[j];
+            order->old_id[j] = tmp;
+        }
+    }
+    for (int i = 0; i < v; i++) order->new_id[order->old_id[i]] = i;
+
+    free(degree);
+    free(by_degree);
+    return order;
+}
+
+/**
+ * @brief Builds the adjacency list of the graph under the new numbering.
+ * @return New list; list nodes are allocated in the new vertex order so neighbor walks
+ *         of consecutive vertices also touch consecutive memory. The input list is not freed.
+ */
+graph **renumber_graph(graph **g, int v, const vertex_order *order) {
+    graph **G = malloc(sizeof(graph *) * v);
+
+    for (int i = 0; i < v; i++) {
+        graph **tail = &G[i];
+        for (graph *p = g[order->old_id[i]]; p != NULL; p = p->next) {
+            graph *node = malloc(sizeof(graph));
+            node->x = order->new_id[p->x];
+            *tail = node;
+            tail = &node->next;
+        }
+        *tail = NULL;
+    }
+
+    return G;
+}
+
+void free_vertex_order(vertex_order *order) {
+    free(order->new_id);
+    free(order->old_id);
+    free(order);
+}
+
+/* ---------------------------------- Locality ---------------------------------- */
+
+/**
+ * @brief Measures how close neighbors are in the current numbering.
+ * @note The cache figure replays the access pattern of a planner scanning every vertex and
+ *       reading one int of per-vertex data for each neighbor through a direct-mapped cache.
+ *       It is a model of the miss rate, not a hardware counter.
+ */
+void measure_locality(graph **g, int v, locality_stats *stats) {
+    long long gap_sum = 0, edges = 0, misses = 0;
+    int *tags = malloc(CACHE_LINES * sizeof(int));
+    memset(tags, 0xff, CACHE_LINES * sizeof(int));
+
+    stats->bandwidth = 0;
+    for (int x = 0; x < v; x++) {
+        for (graph *p = g[x]; p != NULL; p = p->next) {
+            int gap = p->x > x ? p->x - x : x - p->x;
+            if (gap > stats->bandwidth) stats->bandwidth = gap;
+            gap_sum += gap;
+            edges++;
+
+            int line = p->x / CACHE_LINE_INTS;
+            if (tags[line % CACHE_LINES] != line) {
+                tags[line % CACHE_LINES] = line;
+                misses++;
+            }
+        }
+    }
+
+    stats->mean_gap = edges ? (double)gap_sum / edges : 0.0;
+    stats->cache_misses = misses;
+    free(tags);
+}
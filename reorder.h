@@ -0,0 +1,30 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "dijkstras.h"
+
+// Vertex orderings selectable through REORDER_MODE in main.c
+#define REORDER_NONE 0  // Keep the IDs of config.in
+#define REORDER_BFS  1  // Breadth-first order
+#define REORDER_RCM  2  // Reverse Cuthill-McKee
+
+// Mapping between the IDs of the input file and the internal IDs
+typedef struct {
+    int v;        /**< Number of vertices. */
+    int *new_id;  /**< new_id[original] = internal ID. */
+    int *old_id;  /**< old_id[internal] = original ID. */
+} vertex_order;
+
+// Locality of an adjacency list under its current numbering
+typedef struct {
+    int bandwidth;           /**< Largest |u - w| over all edges. */
+    double mean_gap;         /**< Mean |u - w| over all edges. */
+    long long cache_misses;  /**< Simulated misses of a 32 KB direct-mapped cache during a neighbor sweep. */
+} locality_stats;
+
+vertex_order *compute_vertex_order(graph **g, int v, int mode);
+graph **renumber_graph(graph **g, int v, const vertex_order *order);
+void free_vertex_order(vertex_order *order);
+void measure_locality(graph **g, int v, locality_stats *stats);
+
+#endif
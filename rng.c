@@ -0,0 +1,26 @@
+#include <stdint.h>
+#include "rng.h"
+
+// SplitMix64 finalizer: a strong bijective mix of a 64-bit value
+static uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Create stream number `stream` of the sequence family identified by `seed`
+void rng_init(rng_stream *rng, uint64_t seed, uint64_t stream) {
+    rng->key = mix64(seed ^ mix64(stream + 0x9e3779b97f4a7c15ULL));
+    rng->counter = 0;
+}
+
+// Next 32 random bits: hash of (key, counter)
+uint32_t rng_next(rng_stream *rng) {
+    uint64_t x = mix64(rng->key + (rng->counter++) * 0x9e3779b97f4a7c15ULL);
+    return (uint32_t)(x >> 32);
+}
+
+// Uniform integer in [0, n), n > 0
+int rng_below(rng_stream *rng, int n) {
+    return (int)(((uint64_t)rng_next(rng) * (uint64_t)n) >> 32);
+}
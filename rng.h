@@ -0,0 +1,17 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Counter-based random stream: the n-th number is a pure function of (key, n),
+// so independent streams can be created for any trial index without shared state.
+typedef struct {
+    uint64_t key;     /**< Derived from the seed and the stream index. */
+    uint64_t counter; /**< Number of values drawn so far. */
+} rng_stream;
+
+void rng_init(rng_stream *rng, uint64_t seed, uint64_t stream);
+uint32_t rng_next(rng_stream *rng);
+int rng_below(rng_stream *rng, int n);
+
+#endif
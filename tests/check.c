@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "check.h"
+#include "dfs_pathfinder.h"
+#include "output.h"
+
+// Adjacency list node, laid out as in main.c
+typedef struct node {
+    int x;
+    struct node *next;
+} graph;
+
+// Globals the modules expect from main.c; the checks run quiet and in text mode
+int IS_QUIET = 1;
+int OUTPUT_FORMAT = OUTPUT_TEXT;
+
+int check_failures = 0;
+
+// Prints the outcome of the test program and returns its exit status
+int check_done(const char *name) {
+    if (check_failures == 0) {
+        printf("%s: ok\n", name);
+        return 0;
+    }
+    printf("%s: %d failed\n", name, check_failures);
+    return 1;
+}
+
+int *check_random_edges(rng_stream *rng, int v, int extra, int *e) {
+    int *edges = malloc(2 * (v - 1 + extra) * sizeof(int));
+    int n = 0;
+
+    // A chain through all vertices in random order, from 0 to v - 1
+    int *perm = malloc(v * sizeof(int));
+    for (int i = 0; i < v; i++) perm[i] = i;
+    for (int i = v - 2; i > 1; i--) {
+        int j = 1 + rng_below(rng, i);
+        int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    for (int i = 0; i + 1 < v; i++) {
+        edges[2 * n] = perm[i];
+        edges[2 * n + 1] = perm[i + 1];
+        n++;
+    }
+    free(perm);
+
+    for (int i = 0; i < extra; i++) {
+        int a = rng_below(rng, v), b = rng_below(rng, v);
+        if (a == b) continue;
+        edges[2 * n] = a;
+        edges[2 * n + 1] = b;
+        n++;
+    }
+    *e = n;
+    return edges;
+}
+
+// Distinct obstacles on vertices other than 0 and v - 1 (start and goal of the checks)
+void check_random_obstacles(rng_stream *rng, int v, int *obstacles, int count) {
+    for (int i = 0; i < count; i++) {
+        int x, dup;
+        do {
+            x = 1 + rng_below(rng, v - 2);
+            dup = 0;
+            for (int j = 0; j < i; j++) dup |= obstacles[j] == x;
+        } while (dup);
+        obstacles[i] = x;
+    }
+}
+
+// Adjacency list with the neighbor order createAdjList() in main.c gives for the same edge list
+graph **check_adjacency(int v, const int *edges, int e) {
+    graph **g = calloc(v, sizeof(graph *));
+    for (int i = 0; i < e; i++) {
+        int a = edges[2 * i], b = edges[2 * i + 1];
+        graph *n = malloc(sizeof(graph));
+        n->x = b;
+        n->next = g[a];
+        g[a] = n;
+        n = malloc(sizeof(graph));
+        n->x = a;
+        n->next = g[b];
+        g[b] = n;
+    }
+    return g;
+}
+
+void check_free_adjacency(graph **g, int v) {
+    for (int i = 0; i < v; i++) {
+        while (g[i] != NULL) {
+            graph *next = g[i]->next;
+            free(g[i]);
+            g[i] = next;
+        }
+    }
+    free(g);
+}
+
+// DFS graph of the same edge list, as createDFSGraph() in main.c builds it
+struct Graph *check_dfs_graph(int v, const int *edges, int e) {
+    struct Graph *g = createGraph(v);
+    for (int i = 0; i < e; i++) addEdge(g, edges[2 * i], edges[2 * i + 1]);
+    return g;
+}
@@ -0,0 +1,36 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+#include "dijkstras.h"
+
+// Failed checks of the test program
+extern int check_failures;
+
+// Records a failure with its location and message, the test goes on
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        check_failures++; \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+    } \
+} while (0)
+
+int check_done(const char *name);
+
+/* ---------------------------------- Random Instances ---------------------------------- */
+
+/**
+ * @brief Random undirected graph in the edge-list form of config.in.
+ * @param edges Receives 2 * *e vertex ids (source, destination pairs); the caller frees it.
+ * @note Vertex 0 and v - 1 are joined by a random chain, so start and goal are connected
+ *       when no obstacle sits on it.
+ */
+int *check_random_edges(rng_stream *rng, int v, int extra, int *e);
+void check_random_obstacles(rng_stream *rng, int v, int *obstacles, int count);
+graph **check_adjacency(int v, const int *edges, int e);
+void check_free_adjacency(graph **g, int v);
+struct Graph *check_dfs_graph(int v, const int *edges, int e);
+
+#endif
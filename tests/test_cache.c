@@ -0,0 +1,144 @@
+#include <stdlib.h>
+#include <string.h>
+#include "cache.h"
+#include "check.h"
+#include "dfs_pathfinder.h"
+
+#define POOL 16  // Queries per graph, asked repeatedly in random order
+
+// A query of the pool; its seed is fixed, so every planner run on it gives the same result
+typedef struct {
+    int start, goal;
+    int obstacles[3];
+    int num_obstacles;
+    uint64_t seed;
+} query;
+
+static int same_path(path_result a, path_result b) {
+    if (a.length != b.length) return 0;
+    for (int i = 0; i < a.length; i++) {
+        if (a.path[i] != b.path[i]) return 0;
+    }
+    return 1;
+}
+
+static int blocked(const query *x, int vertex) {
+    for (int i = 0; i < x->num_obstacles; i++) {
+        if (x->obstacles[i] == vertex) return 1;
+    }
+    return 0;
+}
+
+// Queries to vertex v - 1 on one graph; pairs of them differ in a single obstacle, which the key has to tell apart
+static void make_pool(rng_stream *rng, int v, query *pool) {
+    for (int q = 0; q < POOL; q++) {
+        query *x = &pool[q];
+        if (q % 2 == 1) {
+            *x = pool[q - 1];
+            int moved;
+            do {
+                moved = 1 + rng_below(rng, v - 2);
+            } while (moved == x->start || blocked(x, moved));
+            x->obstacles[x->num_obstacles - 1] = moved;
+        } else {
+            x->goal = v - 1;
+            x->num_obstacles = 1 + rng_below(rng, 2);
+            check_random_obstacles(rng, v, x->obstacles, x->num_obstacles);
+            do {
+                x->start = rng_below(rng, v - 1);
+            } while (blocked(x, x->start));
+        }
+
+        // Equal queries, which small graphs produce, must plan alike: the seed follows the sorted obstacle set
+        if (x->num_obstacles == 2 && x->obstacles[0] > x->obstacles[1]) {
+            int swap = x->obstacles[0];
+            x->obstacles[0] = x->obstacles[1];
+            x->obstacles[1] = swap;
+        }
+        x->seed = (uint64_t)x->start;
+        for (int i = 0; i < x->num_obstacles; i++) x->seed = x->seed * v + x->obstacles[i];
+    }
+}
+
+// The cached planner's answers, hits and misses alike, are the plain planner's
+static void check_dijkstra(graph **g, int v, const query *pool, rng_stream *rng, int max_entries) {
+    path_cache *c = path_cache_create(v, max_entries, 1 << 20);
+    int *mask = calloc(v, sizeof(int));
+    int asked = 0;
+    for (int k = 0; k < 8 * POOL; k++, asked++) {
+        const query *x = &pool[rng_below(rng, POOL)];
+        for (int i = 0; i < x->num_obstacles; i++) mask[x->obstacles[i]] = 1;
+
+        rng_stream a, b;
+        rng_init(&a, x->seed, 0);
+        rng_init(&b, x->seed, 0);
+        path_result plain = dijkstra_rng(g, v, x->start, x->goal, mask, x->num_obstacles, &a);
+        path_result cached = cached_dijkstra(c, g, v, x->start, x->goal, mask, x->num_obstacles, &b);
+        CHECK(same_path(plain, cached), "v=%d query %d -> %d: cached length %d, planned %d", v, x->start, x->goal,
+              cached.length, plain.length);
+
+        for (int i = 0; i < x->num_obstacles; i++) mask[x->obstacles[i]] = 0;
+        free(plain.path);
+        free(cached.path);
+    }
+    CHECK(c->hits + c->misses == asked, "v=%d: %lld hits and %lld misses for %d queries", v, c->hits, c->misses, asked);
+    CHECK(c->entries <= max_entries, "v=%d: %d entries, limit %d", v, c->entries, max_entries);
+    if (max_entries >= POOL) CHECK(c->misses <= POOL && c->evictions == 0, "v=%d: %lld misses for %d distinct queries",
+                                   v, c->misses, POOL);
+    free(mask);
+    path_cache_free(c);
+}
+
+// Same for the DFS, which also reports its steps and moves the obstacles of a miss in place
+static void check_dfs(struct Graph *dfs, int v, const query *pool, rng_stream *rng, int max_entries) {
+    path_cache *c = path_cache_create(v, max_entries, 1 << 20);
+    for (int k = 0; k < 4 * POOL; k++) {
+        const query *x = &pool[rng_below(rng, POOL)];
+        int plain_obstacles[3], cached_obstacles[3];
+        memcpy(plain_obstacles, x->obstacles, sizeof(plain_obstacles));
+        memcpy(cached_obstacles, x->obstacles, sizeof(cached_obstacles));
+
+        rng_stream a, b;
+        rng_init(&a, x->seed, 0);
+        rng_init(&b, x->seed, 0);
+        int plain_steps, cached_steps;
+        path_result plain = planShortestPathDFS(dfs, x->start, x->goal, plain_obstacles, x->num_obstacles,
+                                                &plain_steps, &a, NULL);
+        path_result cached = cached_dfs(c, dfs, x->start, x->goal, cached_obstacles, x->num_obstacles,
+                                        &cached_steps, &b);
+        CHECK(same_path(plain, cached) && (plain.length == 0 || plain_steps == cached_steps),
+              "v=%d DFS query %d -> %d: cached length %d in %d steps, planned %d in %d", v, x->start, x->goal,
+              cached.length, cached_steps, plain.length, plain_steps);
+        free(plain.path);
+        free(cached.path);
+    }
+    CHECK(c->entries <= max_entries, "v=%d: %d DFS entries, limit %d", v, c->entries, max_entries);
+    path_cache_free(c);
+}
+
+int main(void) {
+    rng_stream rng;
+    rng_init(&rng, 31, 0);
+
+    for (int trial = 0; trial < 24; trial++) {
+        int v = 6 + rng_below(&rng, trial % 3 ? 60 : 20), e;
+        int *edges = check_random_edges(&rng, v, v / 2 + rng_below(&rng, v), &e);
+        graph **g = check_adjacency(v, edges, e);
+        query pool[POOL];
+        make_pool(&rng, v, pool);
+
+        // Room for every query, and a cache small enough to evict
+        check_dijkstra(g, v, pool, &rng, POOL);
+        check_dijkstra(g, v, pool, &rng, 3);
+        if (v <= 25) {
+            struct Graph *dfs = check_dfs_graph(v, edges, e);
+            check_dfs(dfs, v, pool, &rng, POOL);
+            check_dfs(dfs, v, pool, &rng, 3);
+            freeGraph(dfs);
+        }
+
+        check_free_adjacency(g, v);
+        free(edges);
+    }
+    return check_done("cache");
+}
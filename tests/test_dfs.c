@@ -0,0 +1,111 @@
+// Workers check for idle ones every few nodes, so that the small graphs below hand work around
+#define DFS_SHARE_INTERVAL 4
+#include "../dfs_pathfinder.c"
+#include "check.h"
+#include "msbfs.h"
+
+// Structure for graph nodes
+typedef struct node {
+    int x;
+    struct node *next;
+} graph;
+
+// Outcome of one search
+typedef struct {
+    path_result path;
+    int steps;
+    struct DFSStats stats;
+} dfs_run;
+
+static dfs_run run_dfs(struct Graph *g, int v, const int *obstacles, int num_obstacles, uint64_t seed, int threads) {
+    int moved[4];
+    memcpy(moved, obstacles, num_obstacles * sizeof(int)); // The searches move their obstacles in place
+
+    dfs_run run;
+    rng_stream rng;
+    rng_init(&rng, seed, 0);
+    if (threads == 0) {
+        run.path = planShortestPathDFS(g, 0, v - 1, moved, num_obstacles, &run.steps, &rng, &run.stats);
+    } else {
+        run.path = planShortestPathDFSParallel(g, 0, v - 1, moved, num_obstacles, &run.steps, &rng, threads, &run.stats);
+    }
+    return run;
+}
+
+/**
+ * @brief A found path is a simple walk from 0 to v - 1 whose steps cover its robot moves and the
+ *        obstacle-free hop distance.
+ * @note The robot waits while obstacles move, so the steps are only bounded from below. The
+ *       parallel search draws from per-task streams and prunes against a bound shared across
+ *       threads, so its step count is not the sequential one.
+ */
+static void check_run(const char *name, graph **adj, int v, const int *hops, const dfs_run *run) {
+    const path_result *p = &run->path;
+    if (p->length == 0) return;
+
+    int valid = p->path[0] == 0 && p->path[p->length - 1] == v - 1;
+    char *seen = calloc(v, 1);
+    for (int i = 0; i < p->length && valid; i++) {
+        valid = !seen[p->path[i]];
+        seen[p->path[i]] = 1;
+        if (i > 0 && valid) {
+            valid = 0;
+            for (graph *n = adj[p->path[i - 1]]; n != NULL && !valid; n = n->next) valid = n->x == p->path[i];
+        }
+    }
+    free(seen);
+    CHECK(valid, "v=%d %s: path of %d vertices is not a simple walk from 0 to %d", v, name, p->length, v - 1);
+    CHECK(run->steps >= p->length - 1 && p->length - 1 >= hops[v - 1], "v=%d %s: %d steps for %d moves, %d hops apart",
+          v, name, run->steps, p->length - 1, hops[v - 1]);
+}
+
+int main(void) {
+    rng_stream rng;
+    rng_init(&rng, 35, 0);
+    int threads[] = {1, 2, 4};
+
+    for (int trial = 0; trial < 80; trial++) {
+        // Now and then a graph large enough for the workers to run out of tasks while others still search
+        int large = trial % 20 == 19;
+        int v = large ? 50 : 6 + rng_below(&rng, 30), e;
+        int *edges = check_random_edges(&rng, v, large ? 2 * v : v / 2 + rng_below(&rng, v), &e);
+        if (trial % 8 == 0) e = 0; // No edges at all: the goal cannot be reached
+        struct Graph *g = check_dfs_graph(v, edges, e);
+        graph **adj = check_adjacency(v, edges, e);
+        int *hops = malloc(v * sizeof(int));
+        bfs_single(adj, v, 0, hops);
+
+        int num_obstacles = 1 + rng_below(&rng, 3), obstacles[3];
+        check_random_obstacles(&rng, v, obstacles, num_obstacles);
+
+        dfs_run sequential = run_dfs(g, v, obstacles, num_obstacles, trial, 0);
+        check_run("sequential", adj, v, hops, &sequential);
+        CHECK(hops[v - 1] >= 0 || sequential.path.length == 0, "v=%d: sequential search reached an unreachable goal", v);
+
+        for (int k = 0; k < (int)(sizeof(threads) / sizeof(threads[0])); k++) {
+            dfs_run parallel = run_dfs(g, v, obstacles, num_obstacles, trial, threads[k]);
+            check_run("parallel", adj, v, hops, &parallel);
+            CHECK(hops[v - 1] >= 0 || parallel.path.length == 0, "v=%d: %d threads reached an unreachable goal", v,
+                  threads[k]);
+
+            // One worker runs the tasks in a fixed order, so the run repeats exactly
+            if (threads[k] == 1) {
+                dfs_run again = run_dfs(g, v, obstacles, num_obstacles, trial, 1);
+                int same = again.path.length == parallel.path.length && again.stats.nodes == parallel.stats.nodes &&
+                           (parallel.path.length == 0 || again.steps == parallel.steps);
+                for (int i = 0; i < parallel.path.length && same; i++) same = again.path.path[i] == parallel.path.path[i];
+                CHECK(same, "v=%d seed=%d: single-thread pool gave %d then %d vertices", v, trial, parallel.path.length,
+                      again.path.length);
+                free(again.path.path);
+            }
+            free(parallel.path.path);
+        }
+
+        free(sequential.path.path);
+        free(hops);
+        check_free_adjacency(adj, v);
+        freeGraph(g);
+        free(edges);
+    }
+    return check_done("dfs");
+}
@@ -0,0 +1,113 @@
+// The width-specialized kernels are static, so the check includes the module to run each of them directly
+#include "../dijkstras.c"
+#include "check.h"
+
+// Outcome of one query on one kernel
+typedef struct {
+    path_result path;
+    long expansions;
+    uint32_t next_draw;  /**< Next value of the stream after the search, shows it made the same draws. */
+} kernel_run;
+
+// Runs a query to completion on the given kernel with masks of `words` words
+static kernel_run run_kernel(graph **g, int v, int start, int goal, int *obstacles, uint64_t seed,
+                             int words, int (*step)(dijkstra_search *, long, const struct timespec *),
+                             void (*first)(dijkstra_search *, int, const int *)) {
+    dijkstra_search ctx;
+    search_alloc(&ctx, g, v);
+    state_table_free(&ctx.table);
+    state_table_init(&ctx.table, words);
+    ctx.step = step;
+    ctx.start = first;
+
+    rng_stream rng;
+    rng_init(&rng, seed, 0);
+    search_begin(&ctx, start, goal, obstacles, &rng);
+    ctx.step(&ctx, 0, NULL);
+
+    kernel_run run;
+    run.path = trace_path(&ctx.table, ctx.goal_state);
+    run.expansions = ctx.expansions;
+    run.next_draw = rng_next(&ctx.rng);
+    search_release(&ctx);
+    return run;
+}
+
+static int same_run(const kernel_run *a, const kernel_run *b) {
+    if (a->path.length != b->path.length || a->expansions != b->expansions || a->next_draw != b->next_draw) return 0;
+    for (int i = 0; i < a->path.length; i++) {
+        if (a->path.path[i] != b->path.path[i]) return 0;
+    }
+    return 1;
+}
+
+// Every fixed-width kernel wide enough for v, and the runtime-width kernel at its own and at a wider width,
+// must expand the same states in the same order as the kernel dijkstra_rng() dispatches to
+static void check_query(graph **g, int v, int start, int goal, int *obstacles, uint64_t seed) {
+    int needed = (v + 63) / 64;
+    kernel_run runs[6];
+    const char *names[6];
+    int n = 0;
+
+    if (needed <= 1) {
+        names[n] = "w64";
+        runs[n++] = run_kernel(g, v, start, goal, obstacles, seed, 1, search_step_w64, search_start_w64);
+    }
+    if (needed <= 2) {
+        names[n] = "w128";
+        runs[n++] = run_kernel(g, v, start, goal, obstacles, seed, 2, search_step_w128, search_start_w128);
+    }
+    if (needed <= 4) {
+        names[n] = "w256";
+        runs[n++] = run_kernel(g, v, start, goal, obstacles, seed, 4, search_step_w256, search_start_w256);
+    }
+    names[n] = "dynamic";
+    runs[n++] = run_kernel(g, v, start, goal, obstacles, seed, needed, search_step_dynamic, search_start_dynamic);
+    names[n] = "dynamic+1";
+    runs[n++] = run_kernel(g, v, start, goal, obstacles, seed, needed + 1, search_step_dynamic, search_start_dynamic);
+
+    // dijkstra_rng() itself, through the dispatch
+    rng_stream rng;
+    rng_init(&rng, seed, 0);
+    names[n] = "dijkstra_rng";
+    runs[n].path = dijkstra_rng(g, v, start, goal, obstacles, 0, &rng);
+    runs[n].expansions = runs[0].expansions; // Not reported, the path and stream have to match
+    runs[n++].next_draw = rng_next(&rng);
+
+    for (int k = 1; k < n; k++) {
+        CHECK(same_run(&runs[0], &runs[k]), "v=%d seed=%llu: %s (length %d, %ld expansions) differs from %s "
+              "(length %d, %ld expansions)", v, (unsigned long long)seed, names[k], runs[k].path.length,
+              runs[k].expansions, names[0], runs[0].path.length, runs[0].expansions);
+    }
+    for (int k = 0; k < n; k++) free(runs[k].path.path);
+}
+
+int main(void) {
+    rng_stream rng;
+    rng_init(&rng, 29, 0);
+
+    // Sizes on both sides of each kernel width
+    int sizes[] = {5, 20, 63, 64, 65, 100, 128, 129, 200, 256, 257, 400};
+    for (int k = 0; k < (int)(sizeof(sizes) / sizeof(sizes[0])); k++) {
+        for (int trial = 0; trial < 6; trial++) {
+            int v = sizes[k], e;
+            int *edges = check_random_edges(&rng, v, v / 2 + rng_below(&rng, v), &e);
+            graph **g = check_adjacency(v, edges, e);
+
+            int num_obstacles = 1 + rng_below(&rng, v / 4 + 1);
+            if (num_obstacles > v - 2) num_obstacles = v - 2;
+            int *list = malloc(num_obstacles * sizeof(int));
+            int *obstacles = calloc(v, sizeof(int));
+            check_random_obstacles(&rng, v, list, num_obstacles);
+            for (int i = 0; i < num_obstacles; i++) obstacles[list[i]] = 1;
+
+            check_query(g, v, 0, v - 1, obstacles, 1000 * k + trial);
+
+            free(list);
+            free(obstacles);
+            check_free_adjacency(g, v);
+            free(edges);
+        }
+    }
+    return check_done("dijkstra");
+}
@@ -0,0 +1,155 @@
+// The check replays the obstacle moves of a navigation run, so it includes the module to reach them
+#include "../grid.c"
+#include <limits.h>
+#include "check.h"
+
+// Random map with walls and parked obstacles; cell 0 and the last cell are kept free
+static grid_map *random_grid(rng_stream *rng, int width, int height, int connectivity, int wall_percent,
+                             int num_obstacles) {
+    grid_map *m = calloc(1, sizeof(grid_map));
+    int cells = width * height;
+    int words = (cells + 63) / 64;
+    m->width = width;
+    m->height = height;
+    m->connectivity = connectivity;
+    m->walls = calloc(words + 1, sizeof(uint64_t));
+    m->occupied = calloc(words + 1, sizeof(uint64_t));
+    for (int i = 1; i < cells - 1; i++) {
+        if ((int)rng_below(rng, 100) < wall_percent) m->walls[i >> 6] |= 1ULL << (i & 63);
+    }
+
+    m->obstacle_cells = malloc((num_obstacles + 1) * sizeof(int));
+    for (int k = 0; k < num_obstacles; k++) {
+        int c = 1 + rng_below(rng, cells - 2);
+        if ((m->walls[c >> 6] | m->occupied[c >> 6]) >> (c & 63) & 1) continue;
+        m->occupied[c >> 6] |= 1ULL << (c & 63);
+        m->obstacle_cells[m->num_obstacles++] = c;
+    }
+
+    m->g_cost = malloc(cells * sizeof(int));
+    m->parent = malloc(cells * sizeof(int));
+    m->seen = calloc(cells, sizeof(int));
+    m->closed = calloc(cells, sizeof(int));
+    return m;
+}
+
+static int blocked(const grid_map *m, const uint64_t *bits, int x, int y) {
+    if (x < 0 || y < 0 || x >= m->width || y >= m->height) return 1;
+    int i = y * m->width + x;
+    return (m->walls[i >> 6] >> (i & 63) & 1) || (bits && bits[i >> 6] >> (i & 63) & 1);
+}
+
+// Cost of a single move, -1 if it is not allowed (diagonals need both side cells free)
+static int move_cost(const grid_map *m, const uint64_t *occupied, int from, int to) {
+    int w = m->width;
+    int x = from % w, y = from / w, nx = to % w, ny = to / w;
+    int dx = abs(nx - x), dy = abs(ny - y);
+    if (dx > 1 || dy > 1 || dx + dy == 0 || blocked(m, occupied, nx, ny)) return -1;
+    if (dx + dy == 1) return 10;
+    if (m->connectivity == 4 || blocked(m, occupied, nx, y) || blocked(m, occupied, x, ny)) return -1;
+    return 14;
+}
+
+// Plain Dijkstra over every cell with the same move rules, the cost of the best path or -1
+static int reference_cost(const grid_map *m, int start, int goal) {
+    int cells = m->width * m->height;
+    int *dist = malloc(cells * sizeof(int));
+    char *done = calloc(cells, 1);
+    for (int i = 0; i < cells; i++) dist[i] = INT_MAX;
+    dist[start] = 0;
+
+    while (1) {
+        int c = -1;
+        for (int i = 0; i < cells; i++) {
+            if (!done[i] && dist[i] != INT_MAX && (c < 0 || dist[i] < dist[c])) c = i;
+        }
+        if (c < 0 || c == goal) break;
+        done[c] = 1;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int x = c % m->width + dx, y = c / m->width + dy;
+                if (x < 0 || y < 0 || x >= m->width || y >= m->height) continue;
+                int cost = move_cost(m, m->occupied, c, y * m->width + x);
+                if (cost > 0 && dist[c] + cost < dist[y * m->width + x]) dist[y * m->width + x] = dist[c] + cost;
+            }
+        }
+    }
+
+    int result = dist[goal] == INT_MAX ? -1 : dist[goal];
+    free(done);
+    free(dist);
+    return result;
+}
+
+// The JPS path is made of legal moves from start to goal and costs as much as the reference path
+static void check_jps(grid_map *m, int start, int goal) {
+    long expansions = 0;
+    path_result p = grid_jps(m, start, goal, &expansions);
+    int expected = reference_cost(m, start, goal);
+
+    int cost = p.path ? 0 : -1;
+    for (int i = 1; i < p.length && cost >= 0; i++) {
+        int step = move_cost(m, m->occupied, p.path[i - 1], p.path[i]);
+        CHECK(step > 0, "%dx%d/%d: illegal move %d -> %d", m->width, m->height, m->connectivity, p.path[i - 1], p.path[i]);
+        cost = step > 0 ? cost + step : -1;
+    }
+    CHECK(!p.path || (p.path[0] == start && p.path[p.length - 1] == goal), "%dx%d/%d: path does not join %d and %d",
+          m->width, m->height, m->connectivity, start, goal);
+    CHECK(cost == expected, "%dx%d/%d: JPS cost %d, Dijkstra %d from %d to %d", m->width, m->height, m->connectivity,
+          cost, expected, start, goal);
+    free(p.path);
+}
+
+/**
+ * @brief Navigation with moving obstacles: every robot move is legal when it is made.
+ * @param twin Copy of the map the run does not touch; the check replays the run's obstacle
+ *        moves on it from the same stream to know where the obstacles were at each step.
+ */
+static void check_navigate(grid_map *m, grid_map *twin, int start, int goal, uint64_t seed) {
+    rng_stream rng;
+    rng_init(&rng, seed, 0);
+    grid_stats stats;
+    path_result p = grid_navigate(m, start, goal, 4000, &rng, &stats);
+    if (p.path) {
+        CHECK(p.length == stats.steps + 1, "trace of %d cells for %d steps", p.length, stats.steps);
+        CHECK(p.path[0] == start && p.path[p.length - 1] == goal, "trace does not join %d and %d", start, goal);
+
+        rng_init(&rng, seed, 0);
+        for (int i = 1; i < p.length; i++) {
+            if (rng_below(&rng, 2) == 0) {
+                CHECK(p.path[i] == p.path[i - 1] || move_cost(twin, twin->occupied, p.path[i - 1], p.path[i]) > 0,
+                      "%dx%d/%d step %d: robot moved %d -> %d past an obstacle or wall", m->width, m->height,
+                      m->connectivity, i, p.path[i - 1], p.path[i]);
+            } else {
+                move_random_obstacle(twin, p.path[i - 1], &rng);
+            }
+        }
+    }
+    free(p.path);
+}
+
+int main(void) {
+    rng_stream rng;
+    rng_init(&rng, 32, 0);
+
+    for (int trial = 0; trial < 120; trial++) {
+        int width = 2 + rng_below(&rng, 40), height = 2 + rng_below(&rng, 30);
+        int connectivity = trial % 2 ? 8 : 4;
+        int wall_percent = rng_below(&rng, 40), num_obstacles = 2 * rng_below(&rng, 6);
+        rng_stream layout = rng;
+        grid_map *m = random_grid(&rng, width, height, connectivity, wall_percent, num_obstacles);
+        grid_map *twin = random_grid(&layout, width, height, connectivity, wall_percent, num_obstacles);
+        int cells = width * height;
+
+        check_jps(m, 0, cells - 1);
+        for (int k = 0; k < 4; k++) {
+            int a = rng_below(&rng, cells), b = rng_below(&rng, cells);
+            if (!blocked(m, m->occupied, a % width, a / width)) check_jps(m, a, b);
+        }
+        if (!blocked(m, m->occupied, width - 1, height - 1)) check_navigate(m, twin, 0, cells - 1, trial);
+
+        free_grid(twin);
+        free_grid(m);
+    }
+    return check_done("grid");
+}
@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include "check.h"
+#include "hierarchy.h"
+
+// Structure for graph nodes
+typedef struct node {
+    int x;
+    struct node *next;
+} graph;
+
+// Hops from start to goal avoiding the blocked vertices, -1 if the goal cannot be reached
+static int reference_hops(graph **g, int v, const unsigned char *blocked, int start, int goal) {
+    int *dist = malloc(v * sizeof(int));
+    int *queue = malloc(v * sizeof(int));
+    for (int i = 0; i < v; i++) dist[i] = -1;
+    int head = 0, tail = 0;
+    dist[start] = 0;
+    queue[tail++] = start;
+    while (head < tail) {
+        int x = queue[head++];
+        for (graph *p = g[x]; p != NULL; p = p->next) {
+            if (dist[p->x] >= 0 || blocked[p->x]) continue;
+            dist[p->x] = dist[x] + 1;
+            queue[tail++] = p->x;
+        }
+    }
+    int hops = blocked[goal] ? -1 : dist[goal];
+    free(queue);
+    free(dist);
+    return hops;
+}
+
+// The hierarchical path is a walk around the obstacles as short as the plain BFS one
+static void check_plan(hierarchy *h, graph **g, int v, int start, int goal, const char *name) {
+    path_result p = hier_plan(h, start, goal);
+    int expected = reference_hops(g, v, h->blocked, start, goal);
+
+    int valid = p.length == 0 || (p.path[0] == start && p.path[p.length - 1] == goal);
+    for (int i = 1; i < p.length && valid; i++) {
+        valid = 0;
+        for (graph *n = g[p.path[i - 1]]; n != NULL && !valid; n = n->next) valid = n->x == p.path[i];
+        valid = valid && !h->blocked[p.path[i]];
+    }
+    CHECK(valid, "v=%d %s: path %d -> %d is not a walk around the obstacles", v, name, start, goal);
+    CHECK(p.length - 1 == expected, "v=%d %s: %d -> %d in %d hops, BFS %d", v, name, start, goal, p.length - 1,
+          expected);
+    free(p.path);
+}
+
+int main(void) {
+    rng_stream rng;
+    rng_init(&rng, 37, 0);
+
+    for (int trial = 0; trial < 60; trial++) {
+        int v = 5 + rng_below(&rng, 300), e;
+        int *edges = check_random_edges(&rng, v, rng_below(&rng, v), &e);
+        if (trial % 6 == 0) e = v / 2; // Part of the chain only: several components
+        graph **g = check_adjacency(v, edges, e);
+        int cluster_size = 1 + rng_below(&rng, trial % 2 ? 16 : v);
+
+        int num_obstacles = 1 + rng_below(&rng, v / 8 + 1);
+        if (num_obstacles > v - 2) num_obstacles = v - 2;
+        int *list = malloc(num_obstacles * sizeof(int));
+        unsigned char *on = calloc(v, 1);
+        int *mask = calloc(v, sizeof(int));
+        check_random_obstacles(&rng, v, list, num_obstacles);
+        for (int i = 0; i < num_obstacles; i++) mask[list[i]] = on[list[i]] = 1;
+        hierarchy *h = hierarchy_build(g, v, mask, cluster_size);
+
+        // Queries between obstacle moves, so the incrementally rebuilt clusters are searched too
+        for (int round = 0; round < 8; round++) {
+            int start;
+            do {
+                start = rng_below(&rng, v);
+            } while (on[start]);
+            check_plan(h, g, v, start, rng_below(&rng, v), "incremental");
+
+            for (int k = 0; k < 3; k++) {
+                int i = rng_below(&rng, num_obstacles), to = rng_below(&rng, v);
+                if (on[to]) continue;
+                hier_set_obstacle(h, list[i], 0);
+                hier_set_obstacle(h, to, 1);
+                on[list[i]] = 0;
+                on[to] = 1;
+                list[i] = to;
+            }
+        }
+
+        // A hierarchy built from scratch on the final layout answers the same
+        for (int i = 0; i < v; i++) mask[i] = on[i];
+        hierarchy *fresh = hierarchy_build(g, v, mask, cluster_size);
+        for (int start = 0; start < v; start += 1 + v / 8) {
+            if (!on[start]) check_plan(fresh, g, v, start, v - 1, "fresh");
+        }
+        for (int c = 0; c < fresh->num_clusters; c++) {
+            CHECK(fresh->clusters[c].num_boundary > 0 || !fresh->clusters[c].dirty, "v=%d: cluster %d without "
+                  "boundary vertices is dirty", v, c);
+        }
+        hierarchy_free(fresh);
+
+        hierarchy_free(h);
+        free(mask);
+        free(on);
+        free(list);
+        check_free_adjacency(g, v);
+        free(edges);
+    }
+    return check_done("hierarchy");
+}
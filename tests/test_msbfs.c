@@ -0,0 +1,70 @@
+#include <stdlib.h>
+#include "check.h"
+#include "msbfs.h"
+
+// Every row of an all-pairs table equals a scalar BFS from its source
+static void check_all_pairs(graph **g, int v) {
+    distance_table *t = build_all_pairs_table(g, v);
+    int *dist = malloc(v * sizeof(int));
+    int bad = 0;
+    for (int s = 0; s < v && !bad; s++) {
+        bfs_single(g, v, s, dist);
+        for (int x = 0; x < v; x++) {
+            if (all_pairs_distance(t, s, x) != dist[x]) {
+                CHECK(0, "v=%d all pairs %d -> %d: %d, BFS %d", v, s, x, all_pairs_distance(t, s, x), dist[x]);
+                bad = 1;
+                break;
+            }
+        }
+    }
+    free(dist);
+    free_distance_table(t);
+}
+
+// Landmark tables with repeated and unordered sources, more than one batch when there are enough vertices
+static void check_landmarks(rng_stream *rng, graph **g, int v) {
+    int num_sources = 1 + rng_below(rng, 2 * MSBFS_BATCH);
+    int *sources = malloc(num_sources * sizeof(int));
+    for (int i = 0; i < num_sources; i++) sources[i] = rng_below(rng, v);
+
+    distance_table *t = build_distance_table(g, v, sources, num_sources);
+    int *dist = malloc(v * sizeof(int));
+    int bad = 0;
+    for (int i = 0; i < num_sources && !bad; i++) {
+        bfs_single(g, v, sources[i], dist);
+        for (int x = 0; x < v; x++) {
+            if (table_distance(t, i, x) != dist[x]) {
+                CHECK(0, "v=%d landmark row %d (source %d) -> %d: %d, BFS %d", v, i, sources[i], x,
+                      table_distance(t, i, x), dist[x]);
+                bad = 1;
+                break;
+            }
+        }
+    }
+    free(dist);
+    free(sources);
+    free_distance_table(t);
+}
+
+int main(void) {
+    rng_stream rng;
+    rng_init(&rng, 28, 0);
+
+    // Sizes around the batch width, sparse and dense, plus graphs with unreachable vertices
+    int sizes[] = {2, 3, 17, 63, 64, 65, MSBFS_BATCH + 1, 300, 700};
+    for (int k = 0; k < (int)(sizeof(sizes) / sizeof(sizes[0])); k++) {
+        for (int trial = 0; trial < 3; trial++) {
+            int v = sizes[k], e;
+            int *edges = check_random_edges(&rng, v, trial == 1 ? 3 * v : 0, &e);
+            if (trial == 2) e /= 2; // Only half of the chain: the other vertices are unreachable from it
+            graph **g = check_adjacency(v, edges, e);
+
+            check_all_pairs(g, v);
+            check_landmarks(&rng, g, v);
+
+            check_free_adjacency(g, v);
+            free(edges);
+        }
+    }
+    return check_done("msbfs");
+}
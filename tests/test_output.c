@@ -0,0 +1,276 @@
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "dfs_pathfinder.h"
+#include "montecarlo.h"
+#include "output.h"
+
+// Writes records through a writer into a temporary file and returns its contents (NUL-terminated)
+static char *capture(void (*emit)(out_writer *, int), int format, long *size) {
+    FILE *fp = tmpfile();
+    static out_writer w;
+    out_init(&w, fp);
+    emit(&w, format);
+    out_flush(&w);
+
+    *size = ftell(fp);
+    char *data = malloc(*size + 1);
+    rewind(fp);
+    *size = (long)fread(data, 1, *size, fp);
+    data[*size] = '\0';
+    fclose(fp);
+    return data;
+}
+
+/* ---------------------------------- Records Under Test ---------------------------------- */
+
+static const int neighbors[] = {4, 17, 123456};
+static const int obstacle_list[] = {3, 9};
+static const int path[] = {0, 2, 5, 6};
+static const long long big = 5000000000LL; // Does not fit in an int
+
+static void write_records(out_writer *w, int format) {
+    if (format == OUTPUT_BINARY) out_binary_header(w);
+    out_adjacency(w, format, 7, neighbors, 3);
+    out_obstacles(w, format, obstacle_list, 2);
+    out_query(w, format, 0, 6);
+    out_result(w, format, PLANNER_DFS, path, 4, 11, 0.25);
+    out_result(w, format, PLANNER_DIJKSTRA, NULL, 0, 0, 0.5);
+
+    out_field fields[] = {
+        {"small", "a ", OUT_FIELD_INT, -42, 0},
+        {"large", ", b ", OUT_FIELD_LONG, big, 0},
+        {NULL, ", rate ", OUT_FIELD_PERCENT, 1, 4},
+        {"hidden", NULL, OUT_FIELD_LONG, 3, 0},
+    };
+    out_stats(w, format, REC_CACHE, "check", fields, 4, "%\n");
+}
+
+/* ---------------------------------- NDJSON ---------------------------------- */
+
+// Integer value of "key" in a JSON line, fails the check if it is missing
+static long long json_long(const char *line, const char *key) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *p = strstr(line, pattern);
+    CHECK(p != NULL, "key %s missing in %s", key, line);
+    return p ? strtoll(p + strlen(pattern), NULL, 10) : 0;
+}
+
+// Integer array of "key" in a JSON line; returns the number of values read
+static int json_ints(const char *line, const char *key, int *values, int capacity) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":[", key);
+    const char *p = strstr(line, pattern);
+    CHECK(p != NULL, "array %s missing in %s", key, line);
+    if (p == NULL) return 0;
+    p += strlen(pattern);
+
+    int n = 0;
+    while (*p != ']' && n < capacity) {
+        char *end;
+        values[n++] = (int)strtol(p, &end, 10);
+        p = *end == ',' ? end + 1 : end;
+    }
+    return n;
+}
+
+static void check_ndjson(void) {
+    long size;
+    char *data = capture(write_records, OUTPUT_NDJSON, &size);
+    char *lines[8];
+    int n = 0;
+    for (char *line = strtok(data, "\n"); line && n < 8; line = strtok(NULL, "\n")) lines[n++] = line;
+    CHECK(n == 6, "expected 6 NDJSON lines, got %d", n);
+    if (n != 6) {
+        free(data);
+        return;
+    }
+
+    int values[8];
+    CHECK(strstr(lines[0], "\"type\":\"adjacency\"") != NULL, "%s", lines[0]);
+    CHECK(json_long(lines[0], "vertex") == 7, "%s", lines[0]);
+    CHECK(json_ints(lines[0], "neighbors", values, 8) == 3 && values[0] == 4 && values[2] == 123456, "%s", lines[0]);
+
+    CHECK(json_ints(lines[1], "vertices", values, 8) == 2 && values[0] == 3 && values[1] == 9, "%s", lines[1]);
+    CHECK(json_long(lines[2], "start") == 0 && json_long(lines[2], "goal") == 6, "%s", lines[2]);
+
+    CHECK(strstr(lines[3], "\"planner\":\"dfs\",\"found\":true") != NULL, "%s", lines[3]);
+    CHECK(json_long(lines[3], "steps") == 11, "%s", lines[3]);
+    CHECK(json_ints(lines[3], "path", values, 8) == 4 && memcmp(values, path, sizeof(path)) == 0, "%s", lines[3]);
+    CHECK(strstr(lines[4], "\"planner\":\"dijkstra\",\"found\":false") != NULL, "%s", lines[4]);
+    CHECK(json_long(lines[4], "steps") == -1 && json_ints(lines[4], "path", values, 8) == 0, "%s", lines[4]);
+
+    CHECK(strstr(lines[5], "\"type\":\"check\"") != NULL, "%s", lines[5]);
+    CHECK(json_long(lines[5], "small") == -42, "%s", lines[5]);
+    CHECK(json_long(lines[5], "large") == big, "%s", lines[5]);
+    CHECK(json_long(lines[5], "hidden") == 3, "%s", lines[5]);
+    CHECK(strstr(lines[5], "rate") == NULL, "text-only field in %s", lines[5]);
+    free(data);
+}
+
+/* ---------------------------------- Binary ---------------------------------- */
+
+// Little-endian reader over a captured binary stream
+typedef struct {
+    const unsigned char *p;
+    const unsigned char *end;
+} reader;
+
+static long long read_le(reader *r, int bytes) {
+    unsigned long long u = 0;
+    if (r->end - r->p < bytes) {
+        CHECK(0, "binary stream ends early");
+        r->p = r->end;
+        return 0;
+    }
+    for (int i = 0; i < bytes; i++) u |= (unsigned long long)r->p[i] << (8 * i);
+    r->p += bytes;
+    return bytes == 4 ? (long long)(int)(unsigned int)u : (long long)u;
+}
+
+static int read_i32(reader *r) {
+    return (int)read_le(r, 4);
+}
+
+static void check_binary(void) {
+    long size;
+    char *data = capture(write_records, OUTPUT_BINARY, &size);
+    reader r = {(const unsigned char *)data, (const unsigned char *)data + size};
+
+    CHECK(size >= 4 && memcmp(data, "MGMP", 4) == 0, "missing magic");
+    r.p += 4;
+    CHECK(read_i32(&r) == 3, "unexpected format version");
+
+    CHECK(read_i32(&r) == REC_ADJACENCY, "adjacency tag");
+    CHECK(read_i32(&r) == 7, "adjacency vertex");
+    int count = read_i32(&r);
+    CHECK(count == 3, "adjacency count %d", count);
+    for (int i = 0; i < count && i < 3; i++) CHECK(read_i32(&r) == neighbors[i], "neighbor %d", i);
+
+    CHECK(read_i32(&r) == REC_OBSTACLES, "obstacles tag");
+    CHECK(read_i32(&r) == 2, "obstacle count");
+    CHECK(read_i32(&r) == 3 && read_i32(&r) == 9, "obstacle vertices");
+
+    CHECK(read_i32(&r) == REC_QUERY, "query tag");
+    CHECK(read_i32(&r) == 0 && read_i32(&r) == 6, "start and goal");
+
+    CHECK(read_i32(&r) == REC_RESULT, "result tag");
+    CHECK(read_i32(&r) == PLANNER_DFS, "planner");
+    CHECK(read_i32(&r) == 1, "found");
+    CHECK(read_i32(&r) == 11, "steps");
+    CHECK(read_i32(&r) == 250000, "microseconds");
+    CHECK(read_i32(&r) == 4, "path length");
+    for (int i = 0; i < 4; i++) CHECK(read_i32(&r) == path[i], "path[%d]", i);
+
+    CHECK(read_i32(&r) == REC_RESULT, "second result tag");
+    CHECK(read_i32(&r) == PLANNER_DIJKSTRA, "planner");
+    CHECK(read_i32(&r) == 0 && read_i32(&r) == -1, "not found");
+    CHECK(read_i32(&r) == 500000, "microseconds");
+    CHECK(read_i32(&r) == 0, "empty path");
+
+    CHECK(read_i32(&r) == REC_CACHE, "stats tag");
+    CHECK(read_i32(&r) == -42, "int32 field");
+    CHECK(read_le(&r, 8) == big, "int64 field");
+    CHECK(read_le(&r, 8) == 3, "field left out of the text");
+    CHECK(r.p == r.end, "%ld trailing bytes", (long)(r.end - r.p));
+    free(data);
+}
+
+// Simulation summary with counts and a wall time past the int32 range
+static sim_report report;
+
+static void write_report(out_writer *w, int format) {
+    out_sim_report(w, format, &report);
+}
+
+static void check_simulation(void) {
+    report.trials = 1000;
+    report.threads = 4;
+    report.seed = 0xfedcba9876543210ULL;
+    report.successes = 900;
+    report.min_steps = 3;
+    report.max_steps = 70;
+    report.wall_seconds = 3000.5; // 3.0005e9 microseconds
+    report.step_hist[5] = big;
+    report.step_hist[SIM_STEP_BINS - 1] = 7;
+    report.latency_hist[2] = big + 1;
+
+    long size;
+    char *data = capture(write_report, OUTPUT_BINARY, &size);
+    reader r = {(const unsigned char *)data, (const unsigned char *)data + size};
+    CHECK(read_i32(&r) == REC_SIMULATION, "simulation tag");
+    CHECK(read_i32(&r) == 1000 && read_i32(&r) == 4, "trials and threads");
+    CHECK((unsigned long long)read_le(&r, 8) == report.seed, "seed");
+    CHECK(read_i32(&r) == 900 && read_i32(&r) == 3 && read_i32(&r) == 70, "successes, min and max");
+    CHECK(read_le(&r, 8) == 3000500000LL, "microseconds");
+    CHECK(read_i32(&r) == SIM_STEP_BINS, "step bins");
+    for (int b = 0; b < SIM_STEP_BINS; b++) CHECK(read_le(&r, 8) == report.step_hist[b], "step bin %d", b);
+    CHECK(read_i32(&r) == SIM_LATENCY_BINS, "latency bins");
+    for (int b = 0; b < SIM_LATENCY_BINS; b++) CHECK(read_le(&r, 8) == report.latency_hist[b], "latency bin %d", b);
+    CHECK(r.p == r.end, "%ld trailing bytes", (long)(r.end - r.p));
+    free(data);
+
+    data = capture(write_report, OUTPUT_NDJSON, &size);
+    int values[SIM_STEP_BINS];
+    CHECK(json_long(data, "successes") == 900, "%s", data);
+    CHECK(strstr(data, "\"step_hist\":[0,0,0,0,0,5000000000,0,") != NULL, "step histogram in %s", data);
+    CHECK(json_ints(data, "latency_hist_us_log2", values, SIM_LATENCY_BINS) == SIM_LATENCY_BINS, "%s", data);
+    free(data);
+
+    data = capture(write_report, OUTPUT_TEXT, &size);
+    CHECK(strstr(data, "   5:  5000000000\n") != NULL, "step histogram line");
+    CHECK(strstr(data, ": 5000000001\n") != NULL, "latency histogram line");
+    free(data);
+}
+
+// DFS counters past the int32 range, from a parallel search
+static const struct DFSStats dfs_stats = {big, big + 1, 1000, 12, 3};
+
+static void write_dfs_stats(out_writer *w, int format) {
+    out_dfs_stats(w, format, &dfs_stats);
+}
+
+static void check_dfs_stats(void) {
+    long size;
+    char *data = capture(write_dfs_stats, OUTPUT_BINARY, &size);
+    reader r = {(const unsigned char *)data, (const unsigned char *)data + size};
+    CHECK(read_i32(&r) == REC_DFS_STATS, "DFS stats tag");
+    CHECK(read_le(&r, 8) == big && read_le(&r, 8) == big + 1 && read_le(&r, 8) == 1000, "nodes, probes and hits");
+    CHECK(read_le(&r, 8) == 12 && read_le(&r, 8) == 3, "tasks and steals");
+    CHECK(r.p == r.end, "%ld trailing bytes", (long)(r.end - r.p));
+    free(data);
+
+    data = capture(write_dfs_stats, OUTPUT_NDJSON, &size);
+    CHECK(json_long(data, "nodes") == big && json_long(data, "tt_probes") == big + 1, "%s", data);
+    CHECK(json_long(data, "tasks") == 12 && json_long(data, "steals") == 3, "%s", data);
+    free(data);
+
+    data = capture(write_dfs_stats, OUTPUT_TEXT, &size);
+    CHECK(strstr(data, "DFS nodes: 5000000000, transposition table: 5000000001 probes, 1000 hits (hit rate ") != NULL &&
+          strstr(data, "%)\nParallel DFS: 12 tasks, 3 steals\n") != NULL, "%s", data);
+    free(data);
+}
+
+/* ---------------------------------- Text ---------------------------------- */
+
+static void check_text(void) {
+    long size;
+    char *data = capture(write_records, OUTPUT_TEXT, &size);
+    CHECK(strstr(data, "7:   4 17123456\n") != NULL, "adjacency line");
+    CHECK(strstr(data, "Obstacles at: 3 9 \n") != NULL, "obstacle line");
+    CHECK(strstr(data, "using DFS: 0 2 5 6 \nPath length (robot moves): 3\nTotal steps (robot + obstacles): 11\n") != NULL,
+          "DFS result");
+    CHECK(strstr(data, "No path found\n") != NULL, "missing result");
+    CHECK(strstr(data, "a -42, b 5000000000, rate 25.000000%\n") != NULL, "stats line");
+    free(data);
+}
+
+int main(void) {
+    check_ndjson();
+    check_binary();
+    check_simulation();
+    check_dfs_stats();
+    check_text();
+    return check_done("output");
+}
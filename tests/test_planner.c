@@ -0,0 +1,89 @@
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "dfs_pathfinder.h"
+#include "planner.h"
+
+static int same_path(path_result a, path_result b) {
+    if (a.length != b.length) return 0;
+    for (int i = 0; i < a.length; i++) {
+        if (a.path[i] != b.path[i]) return 0;
+    }
+    return 1;
+}
+
+// A context answers like dijkstra_rng() and leaves the stream where it does, query after query
+static void check_dijkstra(rng_stream *rng, graph **g, int v) {
+    planner_context *p = planner_create(g, v, NULL);
+    int *mask = calloc(v, sizeof(int));
+    int list[4];
+
+    for (int q = 0; q < 12; q++) {
+        int num_obstacles = 1 + rng_below(rng, 3);
+        check_random_obstacles(rng, v, list, num_obstacles);
+        for (int i = 0; i < num_obstacles; i++) mask[list[i]] = 1;
+        int goal = q % 3 ? v - 1 : 1 + rng_below(rng, v - 1); // Goals on obstacles too: no path
+
+        rng_stream a, b;
+        rng_init(&a, q, 0);
+        rng_init(&b, q, 0);
+        path_result plain = dijkstra_rng(g, v, 0, goal, mask, num_obstacles, &a);
+        path_result reused = planner_dijkstra(p, 0, goal, mask, &b);
+        CHECK(same_path(plain, reused), "v=%d query %d: context path of %d vertices, dijkstra_rng %d", v, q,
+              reused.length, plain.length);
+        CHECK(rng_next(&a) == rng_next(&b), "v=%d query %d: streams differ after the search", v, q);
+
+        for (int i = 0; i < num_obstacles; i++) mask[list[i]] = 0;
+        free(plain.path);
+    }
+    free(mask);
+    planner_free(p);
+}
+
+// Same for the DFS, which also reports its steps and hands the obstacles back where they were
+static void check_dfs(rng_stream *rng, struct Graph *dfs, int v) {
+    planner_context *p = planner_create(NULL, v, dfs);
+
+    for (int q = 0; q < 12; q++) {
+        int num_obstacles = 1 + rng_below(rng, 3), list[3], plain_obstacles[3], reused_obstacles[3];
+        check_random_obstacles(rng, v, list, num_obstacles);
+        memcpy(plain_obstacles, list, sizeof(list));
+        memcpy(reused_obstacles, list, sizeof(list));
+
+        rng_stream a, b;
+        rng_init(&a, q, 0);
+        rng_init(&b, q, 0);
+        int plain_steps, reused_steps;
+        path_result plain = planShortestPathDFS(dfs, 0, v - 1, plain_obstacles, num_obstacles, &plain_steps, &a, NULL);
+        path_result reused = planner_dfs(p, 0, v - 1, reused_obstacles, num_obstacles, &reused_steps, &b);
+        CHECK(same_path(plain, reused) && (plain.length == 0 || plain_steps == reused_steps),
+              "v=%d DFS query %d: context path of %d vertices in %d steps, plain %d in %d", v, q, reused.length,
+              reused_steps, plain.length, plain_steps);
+        CHECK(rng_next(&a) == rng_next(&b), "v=%d DFS query %d: streams differ after the search", v, q);
+        CHECK(memcmp(reused_obstacles, list, num_obstacles * sizeof(int)) == 0, "v=%d DFS query %d: obstacles moved", v, q);
+        free(plain.path);
+    }
+    planner_free(p);
+}
+
+int main(void) {
+    rng_stream rng;
+    rng_init(&rng, 36, 0);
+
+    for (int trial = 0; trial < 30; trial++) {
+        int v = 6 + rng_below(&rng, trial % 2 ? 150 : 25), e;
+        int *edges = check_random_edges(&rng, v, v / 2 + rng_below(&rng, v), &e);
+        graph **g = check_adjacency(v, edges, e);
+
+        check_dijkstra(&rng, g, v);
+        if (v <= 30) {
+            struct Graph *dfs = check_dfs_graph(v, edges, e);
+            check_dfs(&rng, dfs, v);
+            freeGraph(dfs);
+        }
+
+        check_free_adjacency(g, v);
+        free(edges);
+    }
+    return check_done("planner");
+}
@@ -0,0 +1,127 @@
+#include <stdlib.h>
+#include "check.h"
+#include "msbfs.h"
+#include "reorder.h"
+
+// Structure for graph nodes
+typedef struct node {
+    int x;
+    struct node *next;
+} graph;
+
+// new_id and old_id are inverse permutations of 0..v-1
+static int check_permutation(const vertex_order *o, int v) {
+    for (int i = 0; i < v; i++) {
+        if (o->new_id[i] < 0 || o->new_id[i] >= v || o->old_id[o->new_id[i]] != i) {
+            CHECK(0, "v=%d: vertex %d maps to %d", v, i, o->new_id[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// The renumbered lists are the original ones, renamed and in the same order
+static void check_renumbered(graph **g, graph **r, int v, const vertex_order *o) {
+    for (int i = 0; i < v; i++) {
+        graph *p = g[i], *q = r[o->new_id[i]];
+        while (p && q && o->new_id[p->x] == q->x) {
+            p = p->next;
+            q = q->next;
+        }
+        CHECK(p == NULL && q == NULL, "v=%d: neighbors of %d differ after renumbering", v, i);
+    }
+}
+
+// Hop distances do not depend on the numbering
+static void check_distances(graph **g, graph **r, int v, const vertex_order *o, int source) {
+    int *dist = malloc(v * sizeof(int));
+    int *renumbered = malloc(v * sizeof(int));
+    bfs_single(g, v, source, dist);
+    bfs_single(r, v, o->new_id[source], renumbered);
+    for (int x = 0; x < v; x++) {
+        if (renumbered[o->new_id[x]] != dist[x]) {
+            CHECK(0, "v=%d: hops %d -> %d are %d, %d after renumbering", v, source, x, dist[x], renumbered[o->new_id[x]]);
+            break;
+        }
+    }
+    free(renumbered);
+    free(dist);
+}
+
+static int adjacent(graph **g, int a, int b) {
+    for (graph *p = g[a]; p != NULL; p = p->next) {
+        if (p->x == b) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Plans the same query on both numberings and compares the paths in the original IDs.
+ * @note The obstacle moves draw the k-th obstacle in ID order, so only single-obstacle queries
+ *       make the same draws under both numberings and must give the same path. With more
+ *       obstacles the renumbered path only has to be a walk from start to goal in the original graph.
+ */
+static void check_paths(graph **g, graph **r, int v, const vertex_order *o, int *obstacles, int num_obstacles,
+                        uint64_t seed) {
+    int *moved = calloc(v, sizeof(int));
+    for (int i = 0; i < v; i++) moved[o->new_id[i]] = obstacles[i];
+
+    rng_stream a, b;
+    rng_init(&a, seed, 0);
+    rng_init(&b, seed, 0);
+    path_result p = dijkstra_rng(g, v, 0, v - 1, obstacles, num_obstacles, &a);
+    path_result q = dijkstra_rng(r, v, o->new_id[0], o->new_id[v - 1], moved, num_obstacles, &b);
+    for (int i = 0; i < q.length; i++) q.path[i] = o->old_id[q.path[i]];
+
+    if (num_obstacles == 1) {
+        int same = p.length == q.length && rng_next(&a) == rng_next(&b);
+        for (int i = 0; i < p.length && same; i++) same = p.path[i] == q.path[i];
+        CHECK(same, "v=%d seed=%llu: renumbered path (length %d) differs from the original one (length %d)", v,
+              (unsigned long long)seed, q.length, p.length);
+    } else if (q.length > 0) {
+        int walk = q.path[0] == 0 && q.path[q.length - 1] == v - 1;
+        for (int i = 1; i < q.length && walk; i++) {
+            walk = q.path[i] == q.path[i - 1] || adjacent(g, q.path[i - 1], q.path[i]);
+        }
+        CHECK(walk, "v=%d seed=%llu: renumbered path is not a walk from 0 to %d", v, (unsigned long long)seed, v - 1);
+    }
+
+    free(p.path);
+    free(q.path);
+    free(moved);
+}
+
+int main(void) {
+    rng_stream rng;
+    rng_init(&rng, 30, 0);
+
+    for (int trial = 0; trial < 300; trial++) {
+        int v = 5 + rng_below(&rng, 120), e;
+        int mode = trial % 2 ? REORDER_RCM : REORDER_BFS;
+        int *edges = check_random_edges(&rng, v, v / 2 + rng_below(&rng, v), &e);
+        if (trial % 10 == 0) e = v / 2; // Only part of the chain: several components to number
+        graph **g = check_adjacency(v, edges, e);
+
+        // Few obstacles: with many of them an unreachable goal makes the state space explode
+        int num_obstacles = trial % 3 ? 1 : 1 + rng_below(&rng, 3);
+        int list[3];
+        int *obstacles = calloc(v, sizeof(int));
+        check_random_obstacles(&rng, v, list, num_obstacles);
+        for (int i = 0; i < num_obstacles; i++) obstacles[list[i]] = 1;
+
+        vertex_order *o = compute_vertex_order(g, v, mode);
+        if (check_permutation(o, v)) {
+            graph **r = renumber_graph(g, v, o);
+            check_renumbered(g, r, v, o);
+            check_distances(g, r, v, o, rng_below(&rng, v));
+            check_paths(g, r, v, o, obstacles, num_obstacles, trial);
+            check_free_adjacency(r, v);
+        }
+
+        free_vertex_order(o);
+        free(obstacles);
+        check_free_adjacency(g, v);
+        free(edges);
+    }
+    return check_done("reorder");
+}